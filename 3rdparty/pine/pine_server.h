@@ -121,6 +121,9 @@ namespace pine
 			MsgUUID = 0xD,          /**< Returns the game UUID. */
 			MsgGameVersion = 0xE,   /**< Returns the game verion. */
 			MsgStatus = 0xF,        /**< Returns the emulator status. */
+			MsgReadBulk = 0x10,     /**< Read an arbitrary-length range of memory. */
+			MsgWriteBulk = 0x11,    /**< Write an arbitrary-length range of memory. */
+			MsgReadScatter = 0x12,  /**< Read a list of memory ranges. */
 			MsgUnimplemented = 0xFF /**< Unimplemented IPC message. */
 		};
 
@@ -331,6 +334,72 @@ namespace pine
 						return error();
 					break;
 				}
+				case MsgReadBulk:
+				{
+					//         MsgReadBulk (1 byte)
+					//         |  Memory address (4 byte)
+					//         |  |           Size (4 byte)
+					//         |  |           |
+					// format: XX YY YY YY YY SS SS SS SS
+					// reply: XX <size bytes of memory>
+					if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size))
+						return error();
+					const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+					const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+					if (!SafetyChecks(buf_cnt, 8, ret_cnt, size, buf_size) || !Impl::check_range(a, size))
+						return error();
+					Impl::read_bytes(a, &ret_buffer[ret_cnt], size);
+					ret_cnt += size;
+					buf_cnt += 8;
+					break;
+				}
+				case MsgWriteBulk:
+				{
+					// format: XX YY YY YY YY SS SS SS SS <size bytes of data>
+					if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size))
+						return error();
+					const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+					const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+					if (!SafetyChecks(buf_cnt, usz{8} + size, ret_cnt, 0, buf_size) || !Impl::check_range(a, size, vm::page_writable))
+						return error();
+					Impl::write_bytes(a, &buf[buf_cnt + 8], size);
+					buf_cnt += usz{8} + size;
+					break;
+				}
+				case MsgReadScatter:
+				{
+					//         MsgReadScatter (1 byte)
+					//         |  Count (4 byte)
+					//         |  |           Address and size pairs (8 byte each)
+					//         |  |           |
+					// format: XX CC CC CC CC [YY YY YY YY SS SS SS SS]...
+					// reply: XX <data of all ranges in order>
+					if (!SafetyChecks(buf_cnt, 4, ret_cnt, 0, buf_size))
+						return error();
+					const u32 count = FromArray<u32>(&buf[buf_cnt], 0);
+					buf_cnt += 4;
+					if (!SafetyChecks(buf_cnt, usz{count} * 8, ret_cnt, 0, buf_size))
+						return error();
+					// Validate every range before reading any
+					usz total = 0;
+					for (u32 i = 0; i < count; i++)
+					{
+						const u32 a = FromArray<u32>(&buf[buf_cnt], i * 8);
+						const u32 size = FromArray<u32>(&buf[buf_cnt], i * 8 + 4);
+						total += size;
+						if (!SafetyChecks(buf_cnt, 0, ret_cnt, total, buf_size) || !Impl::check_range(a, size))
+							return error();
+					}
+					for (u32 i = 0; i < count; i++)
+					{
+						const u32 a = FromArray<u32>(&buf[buf_cnt], i * 8);
+						const u32 size = FromArray<u32>(&buf[buf_cnt], i * 8 + 4);
+						Impl::read_bytes(a, &ret_buffer[ret_cnt], size);
+						ret_cnt += size;
+					}
+					buf_cnt += usz{count} * 8;
+					break;
+				}
 				default:
 				{
 					return error();
@@ -542,8 +542,8 @@ public:
 	// Add module (not cached)
 	void add(std::unique_ptr<llvm::Module> _module);
 
-	// Add object (path to obj file)
-	bool add(const std::string& path);
+	// Add object (path to obj file), optionally refuse it if an external symbol is not accepted by check_symbol
+	bool add(const std::string& path, const std::function<bool(const std::string&)>& check_symbol = {});
 
 	// Update global mapping for a single value
 	void update_global_mapping(const std::string& name, u64 addr);
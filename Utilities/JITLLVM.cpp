@@ -768,7 +768,7 @@ void jit_compiler::add(std::unique_ptr<llvm::Module> _module)
 	}
 }
 
-bool jit_compiler::add(const std::string& path)
+bool jit_compiler::add(const std::string& path, const std::function<bool(const std::string&)>& check_symbol)
 {
 	auto cache = ObjectCache::load(path);
 
@@ -780,6 +780,42 @@ bool jit_compiler::add(const std::string& path)
 
 	if (auto object_file = llvm::object::ObjectFile::createObjectFile(*cache))
 	{
+		// Objects can't be removed from the engine, so check that it links before adding it
+		if (check_symbol)
+		{
+			for (const auto& sym : (*object_file)->symbols())
+			{
+				auto flags = sym.getFlags();
+				auto name = sym.getName();
+
+				if (!flags || !name)
+				{
+					llvm::consumeError(flags.takeError());
+					llvm::consumeError(name.takeError());
+					jit_log.error("ObjectCache: Failed to read symbols: %s", path);
+					return false;
+				}
+
+				if (!(*flags & llvm::object::SymbolRef::SF_Undefined) || name->empty())
+				{
+					continue;
+				}
+
+				const std::string str = name->str();
+
+				if (m_engine->getAddressToGlobalIfAvailable(str) || llvm::RTDyldMemoryManager::getSymbolAddressInProcess(str))
+				{
+					continue;
+				}
+
+				if (!check_symbol(str))
+				{
+					jit_log.error("ObjectCache: Unresolved symbol '%s' in %s", str, path);
+					return false;
+				}
+			}
+		}
+
 		m_engine->addObjectFile(llvm::object::OwningBinary<llvm::object::ObjectFile>(std::move(*object_file), std::move(cache)));
 		jit_log.trace("ObjectCache: Successfully added %s", path);
 		return true;
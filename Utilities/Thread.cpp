@@ -10,6 +10,7 @@
 #include "Utilities/JIT.h"
 #include <thread>
 #include <cfenv>
+#include <numeric>
 
 #ifdef ARCH_ARM64
 #include "Emu/CPU/Backends/AArch64/AArch64Signal.h"
@@ -1796,6 +1797,11 @@ static LONG exception_handler(PEXCEPTION_POINTERS pExp) noexcept
 
 	if (pExp->ExceptionRecord->ExceptionCode == EXCEPTION_ACCESS_VIOLATION && !is_executing)
 	{
+		if (vm::try_load_lazy_memory(ptr))
+		{
+			return EXCEPTION_CONTINUE_EXECUTION;
+		}
+
 		u32 addr = 0;
 
 		if (auto [addr0, ok] = vm::try_get_addr(ptr); ok)
@@ -2020,6 +2026,12 @@ static void signal_handler(int /*sig*/, siginfo_t* info, void* uct) noexcept
 	const u64 exec64 = (reinterpret_cast<u64>(info->si_addr) - reinterpret_cast<u64>(vm::g_exec_addr)) / 2;
 	const auto cause = is_executing ? "executing" : is_writing ? "writing" : "reading";
 
+	if (!is_executing && vm::try_load_lazy_memory(info->si_addr))
+	{
+		// Savestate memory has been loaded
+		return;
+	}
+
 	if (auto [addr, ok] = vm::try_get_addr(info->si_addr); ok && !is_executing)
 	{
 		// Try to process access violation
@@ -3337,3 +3349,232 @@ bool thread_ctrl::is_main()
 {
 	return get_tid() == utils::main_tid;
 }
+
+void thread_job_scheduler::init(u32 worker_count, std::unique_ptr<u64[]> keys, u32 job_count)
+{
+	m_workers = std::max<u32>(worker_count, 1);
+	m_order = std::make_unique<u32[]>(job_count);
+	m_ranges = std::make_unique<atomic_t<u64>[]>(m_workers);
+
+	std::vector<u32> sorted(job_count);
+	std::iota(sorted.begin(), sorted.end(), 0);
+
+	// Keep the original order of equal jobs
+	std::stable_sort(sorted.begin(), sorted.end(), [&](u32 a, u32 b)
+	{
+		return keys[a] > keys[b];
+	});
+
+	// Deal the jobs round-robin so every worker starts with the most important ones
+	u32 pos = 0;
+
+	for (u32 w = 0; w < m_workers; w++)
+	{
+		const u32 begin = pos;
+
+		for (u32 i = w; i < job_count; i += m_workers)
+		{
+			m_order[pos++] = sorted[i];
+		}
+
+		m_ranges[w].raw() = begin | (u64{pos} << 32);
+	}
+}
+
+u32 thread_job_scheduler::take(u32 worker, bool steal) noexcept
+{
+	const auto [old, ok] = m_ranges[worker].fetch_op([&](u64& range)
+	{
+		const u32 begin = static_cast<u32>(range);
+		const u32 end = static_cast<u32>(range >> 32);
+
+		if (begin >= end)
+		{
+			return false;
+		}
+
+		range = steal ? begin | (u64{end - 1} << 32) : (begin + 1) | (u64{end} << 32);
+		return true;
+	});
+
+	if (!ok)
+	{
+		return umax;
+	}
+
+	return steal ? static_cast<u32>(old >> 32) - 1 : static_cast<u32>(old);
+}
+
+u32 thread_job_scheduler::pop(u32 worker) noexcept
+{
+	if (const u32 pos = take(worker, false); pos != umax)
+	{
+		return m_order[pos];
+	}
+
+	// Steal from the other workers, starting from the neighbour
+	for (u32 i = 1; i < m_workers; i++)
+	{
+		if (const u32 pos = take((worker + i) % m_workers, true); pos != umax)
+		{
+			return m_order[pos];
+		}
+	}
+
+	return umax;
+}
+
+bool thread_job_scheduler::empty() const noexcept
+{
+	for (u32 w = 0; w < m_workers; w++)
+	{
+		const u64 range = m_ranges[w].load();
+
+		if (static_cast<u32>(range) < static_cast<u32>(range >> 32))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+namespace
+{
+	// Shared with the pool threads which took a helper slot, so it outlives the owner's wait
+	struct worker_pool_job
+	{
+		void (*func)(void*, u32);
+		void* ctx;
+		u32 count;
+
+		// Next index to process and number of processed indices
+		atomic_t<u32> next = 0;
+		atomic_t<u32> done = 0;
+
+		worker_pool_job(void (*func)(void*, u32), void* ctx, u32 count) noexcept
+			: func(func)
+			, ctx(ctx)
+			, count(count)
+		{
+		}
+
+		void work()
+		{
+			for (u32 i; (i = next++) < count;)
+			{
+				func(ctx, i);
+
+				if (++done == count)
+				{
+					done.notify_all();
+				}
+			}
+		}
+	};
+
+	struct worker_pool_thread
+	{
+		void operator()();
+	};
+
+	struct worker_pool
+	{
+		const u32 size = std::clamp<u32>(utils::get_thread_count() / 2, 1, 8) - 1;
+
+		shared_mutex mutex;
+
+		// Helper slots of the pending jobs (a job appears once per requested helper)
+		std::vector<std::shared_ptr<worker_pool_job>> queue;
+
+		atomic_t<u32> signal = 0;
+
+		// Started on first use
+		std::unique_ptr<named_thread_group<worker_pool_thread>> threads;
+
+		static worker_pool& get()
+		{
+			static worker_pool s_pool;
+			return s_pool;
+		}
+
+		std::shared_ptr<worker_pool_job> pop()
+		{
+			std::lock_guard lock(mutex);
+
+			if (queue.empty())
+			{
+				return nullptr;
+			}
+
+			auto job = std::move(queue.back());
+			queue.pop_back();
+			return job;
+		}
+	};
+
+	void worker_pool_thread::operator()()
+	{
+		auto& pool = worker_pool::get();
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			const u32 old = pool.signal;
+
+			if (const auto job = pool.pop())
+			{
+				// func and ctx are only used for claimed indices, which the owner waits for
+				job->work();
+				continue;
+			}
+
+			thread_ctrl::wait_on(pool.signal, old);
+		}
+	}
+}
+
+u32 thread_worker_pool::max_workers()
+{
+	return worker_pool::get().size + 1;
+}
+
+void thread_worker_pool::run_impl(u32 count, u32 worker_limit, void (*func)(void*, u32), void* ctx)
+{
+	auto& pool = worker_pool::get();
+
+	const auto job = std::make_shared<worker_pool_job>(func, ctx, count);
+
+	const u32 helpers = std::min<u32>({worker_limit, count, pool.size + 1}) - 1;
+
+	if (helpers)
+	{
+		std::lock_guard lock(pool.mutex);
+
+		if (!pool.threads)
+		{
+			pool.threads = std::make_unique<named_thread_group<worker_pool_thread>>("Worker Pool ", pool.size);
+		}
+
+		pool.queue.insert(pool.queue.begin(), helpers, job);
+	}
+
+	if (helpers)
+	{
+		pool.signal++;
+		pool.signal.notify_all();
+	}
+
+	job->work();
+
+	for (u32 done; (done = job->done) != count;)
+	{
+		job->done.wait(done);
+	}
+
+	if (helpers)
+	{
+		// Drop the helper slots that have not been taken
+		std::lock_guard lock(pool.mutex);
+		std::erase(pool.queue, job);
+	}
+}
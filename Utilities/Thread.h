@@ -899,3 +899,91 @@ public:
 		::operator delete(static_cast<void*>(m_threads), std::align_val_t{alignof(Thread)});
 	}
 };
+
+// Job distribution for a group of worker threads (see named_thread_group)
+// Jobs are ordered by priority and cost (highest first) and dealt to per-worker ranges.
+// Each worker takes jobs from the front of its own range and steals from the back of the others when it runs out.
+class thread_job_scheduler final
+{
+	// Job indices in execution order, grouped by worker
+	std::unique_ptr<u32[]> m_order;
+
+	// Per-worker ranges in m_order (begin | end << 32)
+	std::unique_ptr<atomic_t<u64>[]> m_ranges;
+
+	u32 m_workers = 0;
+
+	atomic_t<u32> m_next_worker = 0;
+
+	void init(u32 worker_count, std::unique_ptr<u64[]> keys, u32 job_count);
+
+	u32 take(u32 worker, bool steal) noexcept;
+
+public:
+	// Job key: higher priority is taken first, then higher cost
+	static constexpr u64 make_key(u32 priority, u64 cost) noexcept
+	{
+		return (u64{priority} << 32) | (cost < u32{umax} ? cost : u32{umax});
+	}
+
+	// Build the job order, get_key(u32 index) must return the key of each job
+	template <typename F>
+	thread_job_scheduler(u32 worker_count, u32 job_count, F&& get_key)
+	{
+		auto keys = std::make_unique<u64[]>(job_count);
+
+		for (u32 i = 0; i < job_count; i++)
+		{
+			keys[i] = std::invoke(get_key, i);
+		}
+
+		init(worker_count, std::move(keys), job_count);
+	}
+
+	thread_job_scheduler(const thread_job_scheduler&) = delete;
+
+	thread_job_scheduler& operator=(const thread_job_scheduler&) = delete;
+
+	// Allocate worker index (once per worker thread)
+	u32 attach() noexcept
+	{
+		return m_next_worker++ % m_workers;
+	}
+
+	// Get the index of the next job for the worker (umax if there is no job left)
+	u32 pop(u32 worker) noexcept;
+
+	// Check if all jobs have been taken
+	bool empty() const noexcept;
+};
+
+// Shared pool of helper threads for short data-parallel loops (texture conversion, index processing, decryption)
+// The threads are created on first use and live until the process exits.
+class thread_worker_pool final
+{
+	static void run_impl(u32 count, u32 worker_limit, void (*func)(void*, u32), void* ctx);
+
+public:
+	// Maximum parallelism, including the calling thread
+	static u32 max_workers();
+
+	// Call func(index) for every index in [0, count) using up to worker_limit threads, the calling thread takes part
+	template <typename F>
+	static void run(u32 count, u32 worker_limit, F&& func)
+	{
+		if (worker_limit <= 1 || count <= 1)
+		{
+			for (u32 i = 0; i < count; i++)
+			{
+				func(i);
+			}
+
+			return;
+		}
+
+		run_impl(count, worker_limit, [](void* ctx, u32 index)
+		{
+			(*static_cast<std::remove_reference_t<F>*>(ctx))(index);
+		}, const_cast<void*>(static_cast<const void*>(std::addressof(func))));
+	}
+};
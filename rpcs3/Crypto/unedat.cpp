@@ -7,6 +7,8 @@
 #include "utils.h"
 
 #include "Emu/system_utils.hpp"
+#include "Emu/perf_meter.hpp"
+#include "Utilities/Thread.h"
 
 #include "util/asm.hpp"
 #include <algorithm>
@@ -874,6 +876,33 @@ bool EDATADecrypter::ReadHeader()
 	return true;
 }
 
+EDATADecrypter::cached_block* EDATADecrypter::find_cached_block(u32 index)
+{
+	for (cached_block& block : m_cache)
+	{
+		if (block.index == index)
+		{
+			block.last_use = ++m_cache_clock;
+			return &block;
+		}
+	}
+
+	return nullptr;
+}
+
+void EDATADecrypter::store_cached_block(u32 index, const u8* data, u64 size)
+{
+	// Replace the least recently used entry
+	cached_block& block = *std::min_element(m_cache.begin(), m_cache.end(), [](const cached_block& a, const cached_block& b)
+	{
+		return a.last_use < b.last_use;
+	});
+
+	block.index = index;
+	block.last_use = ++m_cache_clock;
+	block.data.assign(data, data + size);
+}
+
 u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 {
 	size = std::min<u64>(size, pos > edatHeader.file_size ? 0 : edatHeader.file_size - pos);
@@ -892,15 +921,70 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 	const u32 starting_block = ::narrow<u32>(pos / edatHeader.block_size);
 	const u32 ending_block = ::narrow<u32>(std::min<u64>(starting_block + num_blocks, total_blocks));
 
-	u64 writeOffset = 0;
+	std::lock_guard lock(m_cache_mutex);
+
+	// Continuing from the previous read (possibly within its last block): read ahead
+	const bool sequential = m_last_end_block != umax && (starting_block == m_last_end_block || starting_block + 1 == m_last_end_block);
+	const u32 fetch_end = sequential ? std::min<u32>(ending_block + readahead_blocks, total_blocks) : ending_block;
+
+	m_last_end_block = ending_block;
+
+	// Source of each requested block: cache entry or freshly decrypted buffer
+	std::vector<std::pair<const u8*, s64>> sources(ending_block - starting_block);
+	std::vector<u32> missing;
+
+	for (u32 i = starting_block; i < fetch_end; i++)
+	{
+		if (const cached_block* block = find_cached_block(i))
+		{
+			perf_meter<"EDAT_HIT"_u64> perf0;
+
+			if (i < ending_block)
+			{
+				sources[i - starting_block] = {block->data.data(), block->data.size()};
+			}
 
-	std::vector<u8> data_buf(edatHeader.block_size + 16);
+			continue;
+		}
+
+		missing.push_back(i);
+	}
+
+	const usz block_stride = edatHeader.block_size + 16;
+
+	std::vector<u8> data_buf(missing.size() * block_stride);
+	std::vector<s64> results(missing.size());
+
+	const auto decrypt_missing = [&](usz j)
+	{
+		perf_meter<"EDATMISS"_u64> perf0;
+		results[j] = decrypt_block(&edata_file, data_buf.data() + j * block_stride, &edatHeader, &npdHeader, reinterpret_cast<uchar*>(&dec_key), missing[j], total_blocks, edatHeader.file_size, true);
+	};
+
+	// Decrypt large batches in parallel on the shared worker pool, blocks are independent
+	// Only native files have positional reads that are safe to issue concurrently (not PKG entry readers or memory streams)
+	constexpr usz blocks_per_worker = 16;
+
+	const bool native_source = edata_file.get_handle() != fs::file{}.get_handle();
+	const u32 worker_count = native_source ? std::min<u32>(::narrow<u32>(missing.size() / blocks_per_worker), thread_worker_pool::max_workers()) : 1;
+
+	thread_worker_pool::run(::size32(missing), worker_count, decrypt_missing);
+
+	for (usz j = 0; j < missing.size(); j++)
+	{
+		if (missing[j] < ending_block)
+		{
+			sources[missing[j] - starting_block] = {data_buf.data() + j * block_stride, results[j]};
+		}
+	}
+
+	u64 writeOffset = 0;
 
 	for (u32 i = starting_block; i < ending_block; i++)
 	{
-		u64 res = decrypt_block(&edata_file, data_buf.data(), &edatHeader, &npdHeader, reinterpret_cast<uchar*>(&dec_key), i, total_blocks, edatHeader.file_size, true);
+		const auto [block_data, res] = sources[i - starting_block];
 
-		if (res == umax)
+		if (res < 0)
 		{
 			edat_log.error("Error Decrypting data");
 			return 0;
@@ -908,7 +992,7 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 
 		const usz skip_start = (i == starting_block ? startOffset : 0);
 
-		if (skip_start >= res)
+		if (skip_start >= static_cast<u64>(res))
 		{
 			break;
 		}
@@ -916,11 +1000,19 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 		const usz end_pos = (i != total_blocks - 1 ? edatHeader.block_size : (edatHeader.file_size - 1) % edatHeader.block_size + 1);
 		const usz read_end = std::min<usz>(res, i == ending_block - 1 ? std::min<usz>(end_pos, (startOffset + size - 1) % edatHeader.block_size + 1) : end_pos);
 
-		std::memcpy(data + writeOffset, data_buf.data() + skip_start, read_end - skip_start);
-		std::memset(data_buf.data(), 0, read_end - skip_start);
+		std::memcpy(data + writeOffset, block_data + skip_start, read_end - skip_start);
 
 		writeOffset += read_end - skip_start;
 	}
 
+	// Keep the most recent blocks (the tail of the read and the read-ahead) for the next reads
+	for (usz j = missing.size() - std::min<usz>(missing.size(), cache_size); j < missing.size(); j++)
+	{
+		if (results[j] >= 0)
+		{
+			store_cached_block(missing[j], data_buf.data() + j * block_stride, results[j]);
+		}
+	}
+
 	return writeOffset;
 }
@@ -2,6 +2,7 @@
 
 #include <array>
 #include "Utilities/File.h"
+#include "Utilities/mutex.h"
 
 constexpr u32 SDAT_FLAG = 0x01000000;
 constexpr u32 EDAT_COMPRESSED_FLAG = 0x00000001;
@@ -82,6 +83,25 @@ struct EDATADecrypter final : fs::file_base
 
 	u128 dec_key{};
 
+	// Decrypted block cache (LRU), also filled by read-ahead on sequential access
+	struct cached_block
+	{
+		u32 index = umax;
+		u64 last_use = 0;
+		std::vector<u8> data;
+	};
+
+	static constexpr u32 cache_size = 8;
+	static constexpr u32 readahead_blocks = 4;
+
+	std::array<cached_block, cache_size> m_cache{};
+	u64 m_cache_clock = 0;
+	u32 m_last_end_block = umax;
+	shared_mutex m_cache_mutex;
+
+	cached_block* find_cached_block(u32 index);
+	void store_cached_block(u32 index, const u8* data, u64 size);
+
 public:
 	EDATADecrypter(fs::file&& input, u128 dec_key = {}, std::string file_name = {}, bool is_key_final = true) noexcept
 		: m_edata_file(std::move(input))
@@ -8,6 +8,7 @@
 #include "Emu/System.h"
 #include "Emu/system_utils.hpp"
 #include "Emu/VFS.h"
+#include "Emu/Cell/timers.hpp"
 #include "unpkg.h"
 #include "util/sysinfo.hpp"
 #include "Loader/PSF.h"
@@ -943,6 +944,26 @@ bool package_reader::fill_data(std::map<std::string, install_entry*>& all_instal
 		return false;
 	}
 
+	// Split large files into segments which can be decrypted independently by all workers (SDAT files must be decrypted as a whole)
+	m_extract_jobs.clear();
+
+	for (usz i = 0; i < m_install_entries.size(); i++)
+	{
+		const install_entry& entry = m_install_entries[i];
+
+		if ((entry.type & 0xff) == PKG_FILE_ENTRY_SDAT || entry.file_size <= SEGMENT_SIZE * 2)
+		{
+			m_extract_jobs.push_back({i, 0, entry.file_size});
+			continue;
+		}
+
+		for (u64 pos = 0; pos < entry.file_size; pos += SEGMENT_SIZE)
+		{
+			m_extract_jobs.push_back({i, pos, std::min<u64>(SEGMENT_SIZE, entry.file_size - pos)});
+		}
+	}
+
+	m_entry_states = std::make_unique<atomic_t<u32>[]>(m_install_entries.size());
 	return true;
 }
 
@@ -951,13 +972,14 @@ fs::file DecryptEDAT(const fs::file& input, const std::string& input_file_name,
 void package_reader::extract_worker()
 {
 	std::vector<u8> read_cache;
+	std::vector<u8> write_buffer;
 
 	while (m_num_failures == 0 && !m_aborted)
 	{
-		// Make sure m_entry_indexer does not exceed m_install_entries
+		// Make sure m_entry_indexer does not exceed m_extract_jobs
 		const usz index = m_entry_indexer.fetch_op([this](usz& v)
 		{
-			if (v < m_install_entries.size())
+			if (v < m_extract_jobs.size())
 			{
 				v++;
 				return true;
@@ -966,25 +988,50 @@ void package_reader::extract_worker()
 			return false;
 		}).first;
 
-		if (index >= m_install_entries.size())
+		if (index >= m_extract_jobs.size())
 		{
 			break;
 		}
 
-		const install_entry& entry = ::at32(m_install_entries, index);
+		const extract_job& job = ::at32(m_extract_jobs, index);
+		const install_entry& entry = ::at32(m_install_entries, job.entry);
 
 		if (!entry.is_dominating())
 		{
 			// Overwritten by another entry
-			m_written_bytes += entry.file_size;
+			m_written_bytes += job.size;
 			continue;
 		}
 
-		const bool is_psp = (entry.type & PKG_FILE_ENTRY_PSP) != 0u;
-
 		const std::string& path = entry.weak_reference->first;
 		const std::string& name = entry.name;
 
+		if (job.offset)
+		{
+			// Trailing segment of a large file: wait for the worker of the first segment to create it
+			m_entry_states[job.entry].wait(0);
+
+			if (m_entry_states[job.entry] != 1)
+			{
+				continue;
+			}
+
+			fs::file out(path, fs::write);
+
+			if (!out)
+			{
+				m_num_failures++;
+				pkg_log.error("Failed to open file %s (error=%s)", path, fs::g_tls_error);
+				continue;
+			}
+
+			out.seek(job.offset);
+			extract_segment(entry, out, job.offset, job.size, write_buffer);
+			continue;
+		}
+
+		const bool is_psp = (entry.type & PKG_FILE_ENTRY_PSP) != 0u;
+
 		if (entry.pad || (entry.type & ~PKG_FILE_ENTRY_KNOWN_BITS))
 		{
 			pkg_log.todo("Entry with unknown type or padding: type=0x%08x, pad=0x%x, name='%s'", entry.type, entry.pad, name);
@@ -1031,186 +1078,193 @@ void package_reader::extract_worker()
 			{
 				bool extract_success = true;
 
-				struct pkg_file_reader : fs::file_base
+				if (!is_buffered)
 				{
-					const std::function<u64(u64, void*, u64)> m_read_func;
-					const install_entry& m_entry;
-					usz m_pos;
-
-					explicit pkg_file_reader(std::function<u64(u64, void* buffer, u64)> read_func, const install_entry& entry) noexcept
-						: m_read_func(std::move(read_func))
-						, m_entry(entry)
-						, m_pos(0)
+					if (job.size != entry.file_size)
 					{
+						// Preallocate the file and let other workers write the remaining segments
+						out.trunc(entry.file_size);
+						m_entry_states[job.entry] = 1;
+						m_entry_states[job.entry].notify_all();
 					}
 
-					fs::stat_t get_stat() override
-					{
-						fs::stat_t stat{};
-						stat.size = m_entry.file_size;
-						return stat;
-					}
-
-					bool trunc(u64) override
+					extract_segment(entry, out, 0, job.size, write_buffer);
+				}
+				else
+				{
+					struct pkg_file_reader : fs::file_base
 					{
-						return false;
-					}
+						const std::function<u64(u64, void*, u64)> m_read_func;
+						const install_entry& m_entry;
+						usz m_pos;
+
+						explicit pkg_file_reader(std::function<u64(u64, void* buffer, u64)> read_func, const install_entry& entry) noexcept
+							: m_read_func(std::move(read_func))
+							, m_entry(entry)
+							, m_pos(0)
+						{
+						}
 
-					u64 read(void* buffer, u64 size) override
-					{
-						const u64 result = pkg_file_reader::read_at(m_pos, buffer, size);
-						m_pos += result;
-						return result;
-					}
+						fs::stat_t get_stat() override
+						{
+							fs::stat_t stat{};
+							stat.size = m_entry.file_size;
+							return stat;
+						}
 
-					u64 read_at(u64 offset, void* buffer, u64 size) override
-					{
-						return m_read_func(offset, buffer, size);
-					}
+						bool trunc(u64) override
+						{
+							return false;
+						}
 
-					u64 write(const void*, u64) override
-					{
-						return 0;
-					}
+						u64 read(void* buffer, u64 size) override
+						{
+							const u64 result = pkg_file_reader::read_at(m_pos, buffer, size);
+							m_pos += result;
+							return result;
+						}
 
-					u64 seek(s64 offset, fs::seek_mode whence) override
-					{
-						const s64 new_pos =
-							whence == fs::seek_set ? offset :
-							whence == fs::seek_cur ? offset + m_pos :
-							whence == fs::seek_end ? offset + size() : -1;
+						u64 read_at(u64 offset, void* buffer, u64 size) override
+						{
+							return m_read_func(offset, buffer, size);
+						}
 
-						if (new_pos < 0)
+						u64 write(const void*, u64) override
 						{
-							fs::g_tls_error = fs::error::inval;
-							return -1;
+							return 0;
 						}
 
-						m_pos = new_pos;
-						return m_pos;
-					}
+						u64 seek(s64 offset, fs::seek_mode whence) override
+						{
+							const s64 new_pos =
+								whence == fs::seek_set ? offset :
+								whence == fs::seek_cur ? offset + m_pos :
+								whence == fs::seek_end ? offset + size() : -1;
+
+							if (new_pos < 0)
+							{
+								fs::g_tls_error = fs::error::inval;
+								return -1;
+							}
+
+							m_pos = new_pos;
+							return m_pos;
+						}
 
-					u64 size() override
-					{
-						return m_entry.file_size;
-					}
+						u64 size() override
+						{
+							return m_entry.file_size;
+						}
 
-					fs::file_id get_id() override
-					{
-						fs::file_id id{};
+						fs::file_id get_id() override
+						{
+							fs::file_id id{};
 
-						id.type.insert(0, "pkg_file_reader: "sv);
-						return id;
-					}
-				};
+							id.type.insert(0, "pkg_file_reader: "sv);
+							return id;
+						}
+					};
 
-				read_cache.clear();
+					read_cache.clear();
 
-				auto reader = std::make_unique<pkg_file_reader>([&, cache_off = u64{umax}](usz pos, void* ptr, usz size) mutable -> u64
-				{
-					if (pos >= entry.file_size || !size)
+					auto reader = std::make_unique<pkg_file_reader>([&, cache_off = u64{umax}](usz pos, void* ptr, usz size) mutable -> u64
 					{
-						return 0;
-					}
+						if (pos >= entry.file_size || !size)
+						{
+							return 0;
+						}
 
-					size = std::min<u64>(entry.file_size - pos, size);
+						size = std::min<u64>(entry.file_size - pos, size);
 
-					u64 size_cache_end = 0;
-					u64 read_size = 0;
+						u64 size_cache_end = 0;
+						u64 read_size = 0;
 
-					// Check if exists in cache
-					if (!read_cache.empty() && cache_off <= pos && pos < cache_off + read_cache.size())
-					{
-						read_size = std::min<u64>(pos + size, cache_off + read_cache.size()) - pos;
+						// Check if exists in cache
+						if (!read_cache.empty() && cache_off <= pos && pos < cache_off + read_cache.size())
+						{
+							read_size = std::min<u64>(pos + size, cache_off + read_cache.size()) - pos;
 
-						std::memcpy(ptr, read_cache.data() + (pos - cache_off), read_size);
-						pos += read_size;
-					}
-					else if (!read_cache.empty() && cache_off < pos + size && cache_off + read_cache.size() >= pos + size)
-					{
-						size_cache_end = size - (std::max<u64>(cache_off, pos) - pos);
+							std::memcpy(ptr, read_cache.data() + (pos - cache_off), read_size);
+							pos += read_size;
+						}
+						else if (!read_cache.empty() && cache_off < pos + size && cache_off + read_cache.size() >= pos + size)
+						{
+							size_cache_end = size - (std::max<u64>(cache_off, pos) - pos);
 
-						std::memcpy(static_cast<u8*>(ptr) + (cache_off - pos), read_cache.data(), size_cache_end);
-						size -= size_cache_end;
-					}
+							std::memcpy(static_cast<u8*>(ptr) + (cache_off - pos), read_cache.data(), size_cache_end);
+							size -= size_cache_end;
+						}
 
-					if (pos >= entry.file_size || !size)
-					{
-						return read_size + size_cache_end;
-					}
+						if (pos >= entry.file_size || !size)
+						{
+							return read_size + size_cache_end;
+						}
 
-					// Try to cache for later
-					if (size <= BUF_SIZE && !size_cache_end && !read_size)
-					{
-						const u64 block_size = std::min<u64>({BUF_SIZE, std::max<u64>(size * 5 / 3, 65536), entry.file_size - pos});
+						// Try to cache for later
+						if (size <= BUF_SIZE && !size_cache_end && !read_size)
+						{
+							const u64 block_size = std::min<u64>({BUF_SIZE, std::max<u64>(size * 5 / 3, 65536), entry.file_size - pos});
 
-						read_cache.resize(block_size + BUF_PADDING);
-						cache_off = pos;
+							read_cache.resize(block_size + BUF_PADDING);
+							cache_off = pos;
 
-						const usz advance_size = decrypt(entry.file_offset + pos, block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data(), read_cache.data());
+							const usz advance_size = decrypt(entry.file_offset + pos, block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data(), read_cache.data());
 
-						if (!advance_size)
-						{
-							cache_off = umax;
-							return 0;
-						}
+							if (!advance_size)
+							{
+								cache_off = umax;
+								return 0;
+							}
 
-						read_cache.resize(advance_size);
+							read_cache.resize(advance_size);
 
-						size = std::min<usz>(advance_size, size);
-						std::memcpy(ptr, read_cache.data(), size);
-						return size;
-					}
+							size = std::min<usz>(advance_size, size);
+							std::memcpy(ptr, read_cache.data(), size);
+							return size;
+						}
 
-					while (read_size < size)
-					{
-						const u64 block_size = std::min<u64>(BUF_SIZE, size - read_size);
+						while (read_size < size)
+						{
+							const u64 block_size = std::min<u64>(BUF_SIZE, size - read_size);
 
-						const usz advance_size = decrypt(entry.file_offset + pos, block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data(), static_cast<u8*>(ptr) + read_size);
+							const usz advance_size = decrypt(entry.file_offset + pos, block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data(), static_cast<u8*>(ptr) + read_size);
 
-						if (!advance_size)
-						{
-							break;
+							if (!advance_size)
+							{
+								break;
+							}
+
+							read_size += advance_size;
+							pos += advance_size;
 						}
 
-						read_size += advance_size;
-						pos += advance_size;
-					}
+						return read_size + size_cache_end;
+					}, entry);
 
-					return read_size + size_cache_end;
-				}, entry);
+					fs::file in_data;
+					in_data.reset(std::move(reader));
 
-				fs::file in_data;
-				in_data.reset(std::move(reader));
+					fs::file final_data = DecryptEDAT(in_data, name, 1, reinterpret_cast<u8*>(&m_header.klicensee));
 
-				fs::file final_data;
+					if (!final_data)
+					{
+						m_num_failures++;
+						pkg_log.error("Failed to decrypt EDAT file %s (error=%s)", path, fs::g_tls_error);
+						break;
+					}
 
-				if (is_buffered)
-				{
-					final_data = DecryptEDAT(in_data, name, 1, reinterpret_cast<u8*>(&m_header.klicensee));
-				}
-				else
-				{
-					final_data = std::move(in_data);
-				}
+					// 16MB buffer
+					std::vector<u8> buffer(std::min<usz>(entry.file_size, 1u << 24) + BUF_PADDING);
 
-				if (!final_data)
-				{
-					m_num_failures++;
-					pkg_log.error("Failed to decrypt EDAT file %s (error=%s)", path, fs::g_tls_error);
-					break;
-				}
-
-				// 16MB buffer
-				std::vector<u8> buffer(std::min<usz>(entry.file_size, 1u << 24) + BUF_PADDING);
+					while (usz read_size = final_data.read(buffer.data(), buffer.size() - BUF_PADDING))
+					{
+						out.write(buffer.data(), read_size);
+						m_written_bytes += read_size;
+					}
 
-				while (usz read_size = final_data.read(buffer.data(), buffer.size() - BUF_PADDING))
-				{
-					out.write(buffer.data(), read_size);
-					m_written_bytes += read_size;
+					final_data.close();
 				}
 
-				final_data.close();
 				out.close();
 
 				if (extract_success)
@@ -1250,6 +1304,35 @@ void package_reader::extract_worker()
 			break;
 		}
 		}
+
+		if (job.size != entry.file_size && !m_entry_states[job.entry])
+		{
+			// The file was not created, release the workers of the other segments
+			m_entry_states[job.entry] = 2;
+			m_entry_states[job.entry].notify_all();
+		}
+	}
+}
+
+void package_reader::extract_segment(const install_entry& entry, const fs::file& out, u64 offset, u64 size, std::vector<u8>& buffer)
+{
+	const bool is_psp = (entry.type & PKG_FILE_ENTRY_PSP) != 0u;
+
+	buffer.resize(std::min<u64>(size, BUF_SIZE) + BUF_PADDING);
+
+	for (u64 pos = offset; pos < offset + size;)
+	{
+		const u64 block_size = std::min<u64>(buffer.size() - BUF_PADDING, offset + size - pos);
+		const usz read_size = decrypt(entry.file_offset + pos, block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data(), buffer.data());
+
+		if (!read_size)
+		{
+			break;
+		}
+
+		out.write(buffer.data(), read_size);
+		m_written_bytes += read_size;
+		pos += read_size;
 	}
 }
 
@@ -1305,7 +1388,9 @@ package_install_result package_reader::extract_data(std::deque<package_reader>&
 
 		if (reader.m_num_failures == 0)
 		{
-			const usz thread_count = std::min<usz>(utils::get_thread_count(), reader.m_install_entries.size());
+			const usz thread_count = std::min<usz>(utils::get_thread_count(), reader.m_extract_jobs.size());
+
+			reader.m_start_time = get_system_time();
 
 			named_thread_group workers("PKG Installer "sv, std::max<u32>(::narrow<u32>(thread_count), 1) - 1, [&]()
 			{
@@ -1319,7 +1404,7 @@ package_install_result package_reader::extract_data(std::deque<package_reader>&
 		num_failures += reader.m_num_failures;
 
 		// We don't count this package as aborted if all entries were processed.
-		if (reader.m_num_failures || (reader.m_aborted && reader.m_entry_indexer < reader.m_install_entries.size()))
+		if (reader.m_num_failures || (reader.m_aborted && reader.m_entry_indexer < reader.m_extract_jobs.size()))
 		{
 			// Clear boot path. We don't want to propagate potentially broken paths to the caller.
 			reader.m_bootable_file_path.clear();
@@ -1478,6 +1563,36 @@ int package_reader::get_progress(int maximum) const
 	return wr >= m_header.data_size ? maximum : ::narrow<int>(wr * maximum / m_header.data_size);
 }
 
+u64 package_reader::get_throughput()
+{
+	const u64 start = m_start_time;
+
+	if (!start)
+	{
+		return 0;
+	}
+
+	if (m_rate_time < start)
+	{
+		// First sample of this extraction
+		m_rate_time = start;
+		m_rate_bytes = 0;
+	}
+
+	const u64 now = get_system_time();
+	const usz written = m_written_bytes;
+
+	// Sliding window: only the data written since the previous sample counts, refreshed at most twice per second
+	if (now - m_rate_time >= 500'000)
+	{
+		m_rate = (written > m_rate_bytes ? written - m_rate_bytes : 0) * 1'000'000 / (now - m_rate_time);
+		m_rate_time = now;
+		m_rate_bytes = written;
+	}
+
+	return m_rate;
+}
+
 void package_reader::abort_extract()
 {
 	m_aborted = true;
@@ -331,6 +331,13 @@ class package_reader
 		}
 	};
 
+	struct extract_job
+	{
+		usz entry{}; // Index in m_install_entries
+		u64 offset{};
+		u64 size{};
+	};
+
 public:
 	package_reader(const std::string& path, fs::file file = {});
 	~package_reader();
@@ -354,6 +361,9 @@ public:
 
 	int get_progress(int maximum = 100) const;
 
+	// Bytes per second written since the previous sample (the caller polls it periodically)
+	u64 get_throughput();
+
 	void abort_extract();
 
 	fs::file &file()
@@ -374,17 +384,25 @@ private:
 	std::span<const char> archive_read_block(u64 offset, void* data_ptr, u64 num_bytes);
 	usz decrypt(u64 offset, u64 size, const uchar* key, void* local_buf);
 	void extract_worker();
+	void extract_segment(const install_entry& entry, const fs::file& out, u64 offset, u64 size, std::vector<u8>& buffer);
 
 	std::deque<install_entry> m_install_entries;
+	std::vector<extract_job> m_extract_jobs;
+	std::unique_ptr<atomic_t<u32>[]> m_entry_states; // 0 = pending, 1 = created, 2 = skipped (for split files)
 	std::string m_install_path;
 	atomic_t<bool> m_aborted = false;
 	atomic_t<usz> m_num_failures = 0;
 	atomic_t<usz> m_entry_indexer = 0;
 	atomic_t<usz> m_written_bytes = 0;
+	atomic_t<u64> m_start_time = 0;
+	u64 m_rate_time = 0;
+	usz m_rate_bytes = 0;
+	u64 m_rate = 0;
 	bool m_was_null = false;
 
 	static constexpr usz BUF_SIZE = 8192 * 1024; // 8 MB
 	static constexpr usz BUF_PADDING = 32;
+	static constexpr u64 SEGMENT_SIZE = 64 * 1024 * 1024; // Files above twice this size are extracted by multiple workers
 
 	bool m_is_valid = false;
 	result m_result = result::not_started;
@@ -4222,8 +4222,6 @@ extern void ppu_precompile(std::vector<std::string>& dir_queue, std::vector<ppu_
 
 	*progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_COMPILING_PPU_MODULES);
 
-	atomic_t<usz> fnext = 0;
-
 	lf_queue<file_info> possible_exec_file_paths;
 
 	// Allow to allocate 2000 times the size of each file for the use of LLVM
@@ -4283,7 +4281,15 @@ extern void ppu_precompile(std::vector<std::string>& dir_queue, std::vector<ppu_
 		}
 	}
 
-	named_thread_group workers("SPRX Worker ", std::min<u32>(software_thread_limit, cpu_thread_limit), [&]
+	const u32 worker_count = std::min<u32>(software_thread_limit, cpu_thread_limit);
+
+	// Start with the largest files so they don't end up being compiled last
+	thread_job_scheduler scheduler(worker_count, ::size32(file_queue), [&](u32 index)
+	{
+		return thread_job_scheduler::make_key(0, file_queue[index].file_size);
+	});
+
+	named_thread_group workers("SPRX Worker ", worker_count, [&]
 	{
 #ifdef __APPLE__
 		pthread_jit_write_protect_np(false);
@@ -4293,7 +4299,9 @@ extern void ppu_precompile(std::vector<std::string>& dir_queue, std::vector<ppu_
 		u32 inc_fdone = 1;
 		u32 restore_mem = 0;
 
-		for (usz func_i = fnext++; func_i < file_queue.size(); func_i = fnext++, g_progr_fdone += std::exchange(inc_fdone, 1))
+		const u32 worker = scheduler.attach();
+
+		for (u32 func_i = scheduler.pop(worker); func_i != umax; func_i = scheduler.pop(worker), g_progr_fdone += std::exchange(inc_fdone, 1))
 		{
 			if (Emu.IsStopped())
 			{
@@ -4774,6 +4782,132 @@ extern void ppu_initialize()
 	}
 }
 
+// Set on the background compilation thread: progress is not reported to the UI
+thread_local bool g_tls_ppu_background_compile = false;
+
+// Compiles modules loaded at runtime while they are executed by the interpreter fallback
+struct ppu_llvm_background
+{
+	lf_queue<shared_ptr<ppu_module<lv2_obj>>> registered;
+
+	shared_mutex mutex;
+
+	// Modules waiting for compilation
+	std::vector<const ppu_module<lv2_obj>*> pending;
+
+	// Module being compiled
+	const ppu_module<lv2_obj>* current = nullptr;
+
+	atomic_t<u32> finished = 0;
+
+	void operator()()
+	{
+		g_tls_ppu_background_compile = true;
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			for (auto slice = registered.pop_all(); slice; slice.pop_front())
+			{
+				const auto& mod = *slice;
+
+				{
+					std::lock_guard lock(mutex);
+
+					if (std::erase(pending, mod.get()) == 0)
+					{
+						// Cancelled
+						continue;
+					}
+
+					current = mod.get();
+				}
+
+				if (!Emu.IsStopped())
+				{
+					ppu_log.notice("LLVM: Compiling module %s in background", mod->path);
+					ppu_initialize(*mod);
+				}
+
+				{
+					std::lock_guard lock(mutex);
+					current = nullptr;
+				}
+
+				finished++;
+				finished.notify_all();
+			}
+
+			thread_ctrl::wait_on(registered.get_wait_atomic(), 0);
+		}
+
+		{
+			std::lock_guard lock(mutex);
+			pending.clear();
+		}
+
+		finished++;
+		finished.notify_all();
+	}
+
+	static constexpr auto thread_name = "PPU LLVM Background"sv;
+};
+
+using ppu_llvm_background_thread = named_thread<ppu_llvm_background>;
+
+extern void ppu_initialize_in_background(shared_ptr<ppu_module<lv2_obj>> info)
+{
+	if (g_cfg.core.ppu_decoder != ppu_decoder_type::llvm || !g_cfg.core.ppu_llvm_background_compile || !ppu_initialize(*info, true))
+	{
+		// Nothing to compile: link immediately
+		ppu_initialize(*info);
+		return;
+	}
+
+	auto& thread = g_fxo->get<ppu_llvm_background_thread>();
+
+	{
+		std::lock_guard lock(thread.mutex);
+		thread.pending.emplace_back(info.get());
+	}
+
+	thread.registered.push(std::move(info));
+}
+
+extern void ppu_cancel_background_initialize(const ppu_module<lv2_obj>& info)
+{
+	if (!g_fxo->is_init<ppu_llvm_background_thread>())
+	{
+		return;
+	}
+
+	auto& thread = g_fxo->get<ppu_llvm_background_thread>();
+
+	if (auto cpu = cpu_thread::get_current())
+	{
+		// Compilation may take a while, don't stall the emulation pause
+		cpu->state += cpu_flag::wait;
+	}
+
+	while (true)
+	{
+		const u32 finished = thread.finished;
+
+		{
+			std::lock_guard lock(thread.mutex);
+
+			std::erase(thread.pending, &info);
+
+			if (thread.current != &info)
+			{
+				return;
+			}
+		}
+
+		// Wait for the module to be compiled before its memory is released
+		thread.finished.wait(finished);
+	}
+}
+
 bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_size)
 {
 	if (g_cfg.core.ppu_decoder != ppu_decoder_type::llvm)
@@ -4882,7 +5016,10 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 #ifdef LLVM_AVAILABLE
 	std::optional<scoped_progress_dialog> progress_dialog;
 
-	if (!check_only)
+	// Background compilation runs while the game is executing: keep it silent
+	const bool report_progress = !g_tls_ppu_background_compile;
+
+	if (!check_only && report_progress)
 	{
 		// Initialize progress dialog
 		progress_dialog.emplace(get_localized_string(localized_string_id::PROGRESS_DIALOG_LOADING_PPU_MODULES));
@@ -4909,9 +5046,6 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 	// Info to load to main JIT instance (true - compiled)
 	std::vector<std::pair<std::string, bool>> link_workload;
 
-	// Sync variable to acquire workloads
-	atomic_t<u32> work_cv = 0;
-
 	bool compiled_new = false;
 
 	bool has_mfvscr = false;
@@ -5519,12 +5653,22 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 	if (!workload.empty())
 	{
 		// Update progress dialog
-		g_progr_ptotal += ::size32(workload);
+		if (progress_dialog)
+		{
+			g_progr_ptotal += ::size32(workload);
 
-		*progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_COMPILING_PPU_MODULES);
+			*progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_COMPILING_PPU_MODULES);
+		}
 
 		const u32 thread_count = std::min(::size32(workload), rpcs3::utils::get_max_threads());
 
+		// Start with the largest modules so they don't end up being compiled last
+		thread_job_scheduler scheduler(thread_count, ::size32(workload), [&](u32 index)
+		{
+			const auto& bounds = workload[index].second.local_bounds;
+			return thread_job_scheduler::make_key(0, utils::sub_saturate<u32>(bounds.second, bounds.first));
+		});
+
 		struct thread_index_allocator
 		{
 			atomic_t<u64> index = 0;
@@ -5532,7 +5676,7 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 
 		struct thread_op
 		{
-			atomic_t<u32>& work_cv;
+			thread_job_scheduler& scheduler;
 			std::vector<std::pair<std::string, ppu_module<lv2_obj>>>& workload;
 			const ppu_module<lv2_obj>& main_module;
 			const std::string& cache_path;
@@ -5540,10 +5684,10 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 
 			std::unique_lock<decltype(jit_core_allocator::sem)> core_lock;
 
-			thread_op(atomic_t<u32>& work_cv, std::vector<std::pair<std::string, ppu_module<lv2_obj>>>& workload
+			thread_op(thread_job_scheduler& scheduler, std::vector<std::pair<std::string, ppu_module<lv2_obj>>>& workload
 				, const cpu_thread* cpu, const ppu_module<lv2_obj>& main_module, const std::string& cache_path, decltype(jit_core_allocator::sem)& sem) noexcept
 
-				: work_cv(work_cv)
+				: scheduler(scheduler)
 				, workload(workload)
 				, main_module(main_module)
 				, cache_path(cache_path)
@@ -5554,7 +5698,7 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 			}
 
 			thread_op(const thread_op& other) noexcept
-				: work_cv(other.work_cv)
+				: scheduler(other.scheduler)
 				, workload(other.workload)
 				, main_module(other.main_module)
 				, cache_path(other.cache_path)
@@ -5577,7 +5721,9 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 	#ifdef __APPLE__
 				pthread_jit_write_protect_np(false);
 	#endif
-				for (u32 i = work_cv++; i < workload.size(); i = work_cv++, g_progr_pdone++)
+				const u32 worker = scheduler.attach();
+
+				for (u32 i = scheduler.pop(worker); i != umax; i = scheduler.pop(worker), g_progr_pdone += u32{report_progress})
 				{
 					if (cpu ? cpu->state.all_of(cpu_flag::exit) : Emu.IsStopped())
 					{
@@ -5619,14 +5765,14 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 		g_watchdog_hold_ctr++;
 
 		named_thread_group threads(fmt::format("PPUW.%u.", ++g_fxo->get<thread_index_allocator>().index), thread_count
-			, thread_op(work_cv, workload, cpu, info, cache_path, g_fxo->get<jit_core_allocator>().sem)
+			, thread_op(scheduler, workload, cpu, info, cache_path, g_fxo->get<jit_core_allocator>().sem)
 			, [&](u32 /*thread_index*/, thread_op& op)
 		{
 			// Allocate "core"
 			op.core_lock.lock();
 
 			// Second check before creating another thread
-			return work_cv < workload.size() && (cpu ? !cpu->state.all_of(cpu_flag::exit) : !Emu.IsStopped());
+			return !scheduler.empty() && (cpu ? !cpu->state.all_of(cpu_flag::exit) : !Emu.IsStopped());
 		});
 
 		threads.join();
@@ -5657,13 +5803,16 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 			return compiled_new;
 		}
 
-		*progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_LINKING_PPU_MODULES);
-
 		// Because linking is faster than compiling, consider each module linkages as a single module compilation in time
 		const bool divide_by_twenty = !workload.empty();
 		const usz increment_link_count_at = (divide_by_twenty ? 20 : 1);
 
-		g_progr_ptotal += static_cast<u32>(utils::aligned_div<u64>(link_workload.size(), increment_link_count_at));
+		if (progress_dialog)
+		{
+			*progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_LINKING_PPU_MODULES);
+
+			g_progr_ptotal += static_cast<u32>(utils::aligned_div<u64>(link_workload.size(), increment_link_count_at));
+		}
 
 		usz mod_index = umax;
 
@@ -5682,7 +5831,7 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 				failed_to_load = true;
 			}
 
-			if (mod_index % increment_link_count_at == (link_workload.size() - 1) % increment_link_count_at)
+			if (progress_dialog && mod_index % increment_link_count_at == (link_workload.size() - 1) % increment_link_count_at)
 			{
 				// Incremenet 'pdone' Nth times where N is link workload size ceil-divided by increment_link_count_at
 				g_progr_pdone++;
@@ -5712,9 +5861,12 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 	// Try to patch all single and unregistered BLRs with the same function (TODO: Maybe generalize it into PIC code detection and patching)
 	ppu_intrp_func_t BLR_func = nullptr;
 
-	const bool showing_only_apply_stage = !g_progr_text.operator bool() && !g_progr_ptotal && !g_progr_ftotal && g_progr_ptotal.compare_and_swap_test(0, 1);
+	const bool showing_only_apply_stage = report_progress && !g_progr_text.operator bool() && !g_progr_ptotal && !g_progr_ftotal && g_progr_ptotal.compare_and_swap_test(0, 1);
 
-	progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_APPLYING_PPU_CODE);
+	if (report_progress)
+	{
+		progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_APPLYING_PPU_CODE);
+	}
 
 	if (jits.empty())
 	{
@@ -180,13 +180,31 @@ spu_function_t spu_recompiler::compile(spu_program&& _func)
 		}
 	}
 
+	// Recompiled with LLVM later if enabled
+	const bool use_tier_up = g_cfg.core.spu_asmjit_llvm_tier_up;
+
+	// Full hash is required by the LLVM profiler
+	m_prof_hash = use_tier_up ? m_hash_start : g_cfg.core.spu_prof ? m_hash_start | 0xffff : 0;
+
+	if (use_tier_up)
+	{
+		// 8-byte instruction for patching (long NOP)
+		static constexpr u8 s_long_nop[8]{0x0f, 0x1f, 0x84, 0, 0, 0, 0, 0};
+		c->embed(s_long_nop, sizeof(s_long_nop));
+	}
+
 	// Load actual PC and check status
 	c->sub(x86::rsp, 0x28);
 	c->mov(pc0->r32(), SPU_OFF_32(pc));
 	c->cmp(SPU_OFF_32(state), 0);
 	c->jnz(label_stop);
 
-	if (g_cfg.core.spu_prof && g_cfg.core.spu_verification)
+	if (use_tier_up)
+	{
+		c->mov(x86::rax, m_prof_hash);
+		c->mov(SPU_OFF_64(block_hash), x86::rax);
+	}
+	else if (g_cfg.core.spu_prof && g_cfg.core.spu_verification)
 	{
 		c->mov(x86::rax, m_hash_start & -0xffff);
 		c->mov(SPU_OFF_64(block_hash), x86::rax);
@@ -755,9 +773,9 @@ spu_function_t spu_recompiler::compile(spu_program&& _func)
 	c->add(SPU_OFF_64(block_counter), ::size32(words) / (words_align / 4));
 
 	// Set block hash for profiling (if enabled)
-	if (g_cfg.core.spu_prof)
+	if (m_prof_hash)
 	{
-		c->mov(x86::rax, m_hash_start | 0xffff);
+		c->mov(x86::rax, m_prof_hash);
 		c->mov(SPU_OFF_64(block_hash), x86::rax);
 	}
 
@@ -903,6 +921,11 @@ spu_function_t spu_recompiler::compile(spu_program&& _func)
 	// Install compiled function pointer
 	const bool added = !add_loc->compiled && add_loc->compiled.compare_and_swap_test(nullptr, fn);
 
+	if (added && use_tier_up)
+	{
+		spu_recompiler_base::tier_up(m_hash_start, add_loc);
+	}
+
 	// Rebuild trampoline if necessary
 	if (!m_spurt->rebuild_ubertrampoline(func.data[0]))
 	{
@@ -1199,9 +1222,9 @@ void spu_recompiler::branch_set_link(u32 target)
 				c->movdqa(x86::dqword_ptr(*cpu, *qw1, 0, ::offset32(&spu_thread::stack_mirror)), x86::xmm0);
 
 				// Set block hash for profiling (if enabled)
-				if (g_cfg.core.spu_prof)
+				if (m_prof_hash)
 				{
-					c->mov(x86::rax, m_hash_start | 0xffff);
+					c->mov(x86::rax, m_prof_hash);
 					c->mov(SPU_OFF_64(block_hash), x86::rax);
 				}
 
@@ -23,6 +23,9 @@ private:
 
 	u32 m_base;
 
+	// Value of block_hash restored for the profiler (0 if not profiled)
+	u64 m_prof_hash = 0;
+
 	// emitter:
 	asmjit::x86::Assembler* c;
 
@@ -749,7 +749,6 @@ void spu_cache::initialize(bool build_existing_cache)
 
 	// Read cache
 	auto func_list = cache.get();
-	atomic_t<usz> fnext{};
 	atomic_t<u8> fail_flag{0};
 
 	auto data_list = g_fxo->get<spu_cache>().precompile_funcs.pop_all();
@@ -779,8 +778,6 @@ void spu_cache::initialize(bool build_existing_cache)
 		data_list = {};
 	}
 
-	atomic_t<usz> data_indexer = 0;
-
 	if (g_cfg.core.spu_decoder == spu_decoder_type::dynamic || g_cfg.core.spu_decoder == spu_decoder_type::llvm)
 	{
 		if (auto compiler = spu_recompiler_base::make_llvm_recompiler(11))
@@ -831,6 +828,12 @@ void spu_cache::initialize(bool build_existing_cache)
 		progress_dialog.emplace(get_localized_string(localized_string_id::PROGRESS_DIALOG_BUILDING_SPU_CACHE));
 	}
 
+	// Cached programs have been executed before, precompiled ones are speculative
+	thread_job_scheduler scheduler(worker_count, ::narrow<u32>(func_list.size() + total_precompile), [&](u32 index)
+	{
+		return index < func_list.size() ? thread_job_scheduler::make_key(1, func_list[index].data.size()) : thread_job_scheduler::make_key(0, 0);
+	});
+
 	named_thread_group workers("SPU Worker ", worker_count, [&]() -> uint
 	{
 #ifdef __APPLE__
@@ -879,101 +882,113 @@ void spu_cache::initialize(bool build_existing_cache)
 		// Fake LS
 		std::vector<be_t<u32>> ls(0x10000);
 
-		usz func_i = fnext++;
+		const u32 worker = scheduler.attach();
 
 		// Ensure some actions are performed on a single thread
-		const bool is_first_thread = func_i == 0;
+		const bool is_first_thread = worker == 0;
 
-		// Build functions
-		for (; func_i < func_list.size(); func_i = fnext++, (showing_progress ? g_progr_pdone : pending_progress) += build_existing_cache ? 1 : 0)
-		{
-			const spu_program& func = std::as_const(func_list)[func_i];
+		u32 last_sec_idx = umax;
 
-			if (Emu.IsStopped() || fail_flag)
+		// Build functions (cached programs first)
+		for (u32 job = scheduler.pop(worker); job != umax; job = scheduler.pop(worker), (showing_progress ? g_progr_pdone : pending_progress) += build_existing_cache ? 1 : 0)
+		{
+			if (job < func_list.size())
 			{
-				continue;
-			}
+				if (last_sec_idx != umax)
+				{
+					// Clear fake LS of the previous section
+					auto& sec = data_list[last_sec_idx];
+					std::memset(ls.data() + sec.vaddr / 4, 0, sec.inst_data.size() * 4);
+					last_sec_idx = umax;
+				}
 
-			// Get data start
-			const u32 start = func.lower_bound;
-			const u32 size0 = ::size32(func.data);
+				const spu_program& func = std::as_const(func_list)[job];
 
-			be_t<u64> hash_start;
-			{
-				sha1_context ctx;
-				u8 output[20];
+				if (Emu.IsStopped() || fail_flag)
+				{
+					continue;
+				}
 
-				sha1_starts(&ctx);
-				sha1_update(&ctx, reinterpret_cast<const u8*>(func.data.data()), func.data.size() * 4);
-				sha1_finish(&ctx, output);
-				std::memcpy(&hash_start, output, sizeof(hash_start));
-			}
+				// Get data start
+				const u32 start = func.lower_bound;
+				const u32 size0 = ::size32(func.data);
 
-			// Check hash against allowed bounds
-			const bool inverse_bounds = g_cfg.core.spu_llvm_lower_bound > g_cfg.core.spu_llvm_upper_bound;
+				be_t<u64> hash_start;
+				{
+					sha1_context ctx;
+					u8 output[20];
 
-			if ((!inverse_bounds && (hash_start < g_cfg.core.spu_llvm_lower_bound || hash_start > g_cfg.core.spu_llvm_upper_bound)) ||
-				(inverse_bounds && (hash_start < g_cfg.core.spu_llvm_lower_bound && hash_start > g_cfg.core.spu_llvm_upper_bound)))
-			{
-				spu_log.error("[Debug] Skipped function %s", fmt::base57(hash_start));
-				result++;
-				continue;
-			}
+					sha1_starts(&ctx);
+					sha1_update(&ctx, reinterpret_cast<const u8*>(func.data.data()), func.data.size() * 4);
+					sha1_finish(&ctx, output);
+					std::memcpy(&hash_start, output, sizeof(hash_start));
+				}
 
-			// Initialize LS with function data only
-			for (u32 i = 0, pos = start; i < size0; i++, pos += 4)
-			{
-				ls[pos / 4] = std::bit_cast<be_t<u32>>(func.data[i]);
-			}
+				// Check hash against allowed bounds
+				const bool inverse_bounds = g_cfg.core.spu_llvm_lower_bound > g_cfg.core.spu_llvm_upper_bound;
 
-			// Call analyser
-			spu_program func2 = compiler->analyse(ls.data(), func.entry_point);
+				if ((!inverse_bounds && (hash_start < g_cfg.core.spu_llvm_lower_bound || hash_start > g_cfg.core.spu_llvm_upper_bound)) ||
+					(inverse_bounds && (hash_start < g_cfg.core.spu_llvm_lower_bound && hash_start > g_cfg.core.spu_llvm_upper_bound)))
+				{
+					spu_log.error("[Debug] Skipped function %s", fmt::base57(hash_start));
+					result++;
+					continue;
+				}
 
-			if (func2 != func)
-			{
-				spu_log.error("[0x%05x] SPU Analyser failed, %u vs %u", func2.entry_point, func2.data.size(), size0);
+				// Initialize LS with function data only
+				for (u32 i = 0, pos = start; i < size0; i++, pos += 4)
+				{
+					ls[pos / 4] = std::bit_cast<be_t<u32>>(func.data[i]);
+				}
+
+				// Call analyser
+				spu_program func2 = compiler->analyse(ls.data(), func.entry_point);
 
-				if (logged_error < 2)
+				if (func2 != func)
 				{
-					std::string log;
-					compiler->dump(func, log);
-					spu_log.notice("[0x%05x] Function: %s", func.entry_point, log);
-					logged_error++;
+					spu_log.error("[0x%05x] SPU Analyser failed, %u vs %u", func2.entry_point, func2.data.size(), size0);
+
+					if (logged_error < 2)
+					{
+						std::string log;
+						compiler->dump(func, log);
+						spu_log.notice("[0x%05x] Function: %s", func.entry_point, log);
+						logged_error++;
+					}
+				}
+				else if (!compiler->compile(std::move(func2)))
+				{
+					// Likely, out of JIT memory. Signal to prevent further building.
+					fail_flag |= 1;
+					continue;
 				}
-			}
-			else if (!compiler->compile(std::move(func2)))
-			{
-				// Likely, out of JIT memory. Signal to prevent further building.
-				fail_flag |= 1;
-				continue;
-			}
 
-			// Clear fake LS
-			std::memset(ls.data() + start / 4, 0, 4 * (size0 - 1));
+				// Clear fake LS
+				std::memset(ls.data() + start / 4, 0, 4 * (size0 - 1));
 
-			result++;
+				result++;
 
-			if (is_first_thread && !showing_progress)
-			{
-				if (!g_progr_text && !g_progr_ptotal && !g_progr_ftotal)
+				if (is_first_thread && !showing_progress)
 				{
-					showing_progress = true;
+					if (!g_progr_text && !g_progr_ptotal && !g_progr_ftotal)
+					{
+						showing_progress = true;
+						g_progr_pdone += pending_progress.exchange(0);
+						g_progr_ptotal += total_funcs;
+						progress_dialog.emplace(get_localized_string(localized_string_id::PROGRESS_DIALOG_BUILDING_SPU_CACHE));
+					}
+				}
+				else if (showing_progress && pending_progress)
+				{
+					// Cover missing progress due to a race
 					g_progr_pdone += pending_progress.exchange(0);
-					g_progr_ptotal += total_funcs;
-					progress_dialog.emplace(get_localized_string(localized_string_id::PROGRESS_DIALOG_BUILDING_SPU_CACHE));
 				}
+
+				continue;
 			}
-			else if (showing_progress && pending_progress)
-			{
-				// Cover missing progress due to a race
-				g_progr_pdone += pending_progress.exchange(0);
-			}
-		}
 
-		u32 last_sec_idx = umax;
+			const usz func_i = job - func_list.size();
 
-		for (func_i = data_indexer++;; func_i = data_indexer++, (showing_progress ? g_progr_pdone : pending_progress) += build_existing_cache ? 1 : 0)
-		{
 			usz passed_count = 0;
 			u32 func_addr = 0;
 			u32 next_func = 0;
@@ -7483,7 +7498,7 @@ struct spu_llvm
 
 	void operator()()
 	{
-		if (g_cfg.core.spu_decoder != spu_decoder_type::llvm)
+		if (g_cfg.core.spu_decoder != spu_decoder_type::llvm && (g_cfg.core.spu_decoder != spu_decoder_type::asmjit || !g_cfg.core.spu_asmjit_llvm_tier_up))
 		{
 			return;
 		}
@@ -7508,10 +7523,20 @@ struct spu_llvm
 		// For synchronization with profiler thread
 		stx::init_mutex prof_mutex;
 
+		// Incremented by the profiler when a program reaches the tier-up threshold (or the threshold changes)
+		atomic_t<u32> hot_signal = 0;
+
 		named_thread profiler("SPU LLVM Profiler"sv, [&]()
 		{
+			u64 last_threshold = 0;
+
 			while (thread_ctrl::state() != thread_state::aborting)
 			{
+				// Minimal number of samples for a program to be recompiled (0: all programs)
+				const u64 threshold = g_cfg.core.spu_llvm_tier_up_threshold;
+
+				bool hot = std::exchange(last_threshold, threshold) != threshold;
+
 				{
 					// Lock if enabled
 					const auto lock = prof_mutex.access();
@@ -7532,14 +7557,20 @@ struct spu_llvm
 						{
 							const auto found = std::as_const(samples).find(name);
 
-							if (found != std::as_const(samples).end())
+							if (found != std::as_const(samples).end() && const_cast<atomic_t<u64>&>(found->second)++ + 1 == threshold)
 							{
-								const_cast<atomic_t<u64>&>(found->second)++;
+								hot = true;
 							}
 						}
 					});
 				}
 
+				if (hot)
+				{
+					hot_signal++;
+					hot_signal.notify_one();
+				}
+
 				// Sleep for a short period if enabled
 				thread_ctrl::wait_for(20, false);
 			}
@@ -7565,8 +7596,25 @@ struct spu_llvm
 		auto workers_ptr = m_workers.load();
 		auto& workers = *workers_ptr;
 
+		const auto notify_workers = [&]()
+		{
+			for (usz i = 0; i < worker_count; i++)
+			{
+				if (notify_compile[i])
+				{
+					(workers.begin() + i)->registered.notify();
+				}
+			}
+
+			std::fill(notify_compile.begin(), notify_compile.end(), 0); // Reset notification flags
+			notify_compile_count = 0;
+			compile_pending = 0;
+		};
+
 		while (thread_ctrl::state() != thread_state::aborting)
 		{
+			const u32 hot_old = hot_signal;
+
 			for (const auto& pair : registered.pop_all())
 			{
 				enqueued.emplace(pair);
@@ -7616,6 +7664,23 @@ struct spu_llvm
 				}
 			}
 
+			if (sample_max < g_cfg.core.spu_llvm_tier_up_threshold)
+			{
+				// Keep cold programs on the first tier until one of them becomes hot or a new one is registered
+				if (notify_compile_count)
+				{
+					notify_workers();
+				}
+
+				thread_ctrl::wait_on_custom<2>([&](atomic_wait::list<4>& list)
+				{
+					list.template set<0>(registered.get_wait_atomic(), 0);
+					list.template set<1>(hot_signal, hot_old);
+				});
+
+				continue;
+			}
+
 			// Start compiling
 			const spu_program& func = found_it->second->data;
 
@@ -7647,17 +7712,7 @@ struct spu_llvm
 			// If there are only a few workers, it postpones notifications until there is some more workload
 			if (notify_compile_count && std::min<u32>(7, utils::aligned_div<u32>(worker_count * 2, 3) + 2) <= compile_pending)
 			{
-				for (usz i = 0; i < worker_count; i++)
-				{
-					if (notify_compile[i])
-					{
-						(workers.begin() + i)->registered.notify();
-					}
-				}
-
-				std::fill(notify_compile.begin(), notify_compile.end(), 0); // Reset notification flags
-				notify_compile_count = 0;
-				compile_pending = 0;
+				notify_workers();
 			}
 
 			worker_index++;
@@ -7691,6 +7746,12 @@ struct spu_llvm
 
 using spu_llvm_thread = named_thread<spu_llvm>;
 
+void spu_recompiler_base::tier_up(u64 hash_start, spu_item* item)
+{
+	// Send work to LLVM compiler thread
+	g_fxo->get<spu_llvm_thread>().registered.push(hash_start, item);
+}
+
 struct spu_fast : public spu_recompiler_base
 {
 	virtual void init() override
@@ -8036,8 +8097,7 @@ struct spu_fast : public spu_recompiler_base
 		}
 		else if (added)
 		{
-			// Send work to LLVM compiler thread
-			g_fxo->get<spu_llvm_thread>().registered.push(m_hash_start, add_loc);
+			tier_up(m_hash_start, add_loc);
 		}
 
 		// Rebuild trampoline if necessary
@@ -8,9 +8,16 @@
 #include "Emu/Cell/lv2/sys_time.h"
 #include "Emu/Memory/vm_reservation.h"
 #include "Emu/RSX/Core/RSXReservationLock.hpp"
+#include "Emu/cache_utils.hpp"
 #include "Crypto/sha1.h"
 #include "Utilities/JIT.h"
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
 #include "SPUThread.h"
 #include "SPUAnalyser.h"
 #include "SPUInterpreter.h"
@@ -64,10 +71,180 @@ const extern spu_decoder<spu_iflag> g_spu_iflag;
 #include "Emu/CPU/Backends/AArch64/AArch64JIT.h"
 #endif
 
+// Persistent storage of relocatable SPU LLVM objects
+struct spu_llvm_object_cache
+{
+	// Object directory (empty if disabled)
+	std::string path;
+
+	shared_mutex mutex;
+
+	// Addresses of external symbols referenced by the objects
+	std::unordered_map<std::string, u64> symbols;
+
+	// Symbol table (addresses relative to the anchor, the directory is unique for the executable)
+	fs::file symbol_file;
+
+	static u64 anchor()
+	{
+		return reinterpret_cast<u64>(&spu_recompiler_base::dispatch);
+	}
+
+	// Symbols located in JIT memory (recreated on every boot)
+	static u64 get_runtime_symbol(std::string_view name)
+	{
+		if (name == "spu_dispatcher")
+			return reinterpret_cast<u64>(spu_runtime::tr_all);
+		if (name == "spu_dispatch")
+			return reinterpret_cast<u64>(spu_runtime::tr_dispatch);
+		if (name == "spu_escape")
+			return reinterpret_cast<u64>(spu_runtime::g_escape);
+
+		return 0;
+	}
+
+	// Check if the address belongs to the executable image (where the anchor is)
+	static bool is_image_address(u64 addr)
+	{
+#ifdef _WIN32
+		HMODULE module = nullptr;
+		HMODULE anchor_module = nullptr;
+
+		constexpr DWORD flags = GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT;
+
+		return GetModuleHandleExW(flags, reinterpret_cast<LPCWSTR>(addr), &module) &&
+			GetModuleHandleExW(flags, reinterpret_cast<LPCWSTR>(anchor()), &anchor_module) &&
+			module == anchor_module;
+#else
+		Dl_info info{};
+		Dl_info anchor_info{};
+
+		return dladdr(reinterpret_cast<void*>(addr), &info) &&
+			dladdr(reinterpret_cast<void*>(anchor()), &anchor_info) &&
+			info.dli_fbase == anchor_info.dli_fbase;
+#endif
+	}
+
+	spu_llvm_object_cache()
+	{
+		const std::string cache_path = rpcs3::cache::get_ppu_cache();
+
+		if (cache_path.empty() || !g_cfg.core.spu_llvm_object_cache || !g_cfg.core.spu_cache || g_cfg.core.spu_debug || g_cfg.core.spu_decoder != spu_decoder_type::llvm)
+		{
+			return;
+		}
+
+		fs::stat_t exe_stat{};
+
+		if (!fs::get_stat(fs::get_executable_path(), exe_stat))
+		{
+			spu_log.error("SPU LLVM: Object cache disabled (failed to stat the executable: %s)", fs::g_tls_error);
+			return;
+		}
+
+		// Settings which affect the generated code, and the executable identity (objects depend on its data layout)
+		const u64 settings[]
+		{
+			static_cast<u64>(g_cfg.core.spu_xfloat_accuracy.get()),
+			g_cfg.core.spu_verification.get(),
+			g_cfg.core.precise_spu_verification.get(),
+			g_cfg.core.use_accurate_dfma.get(),
+			g_cfg.core.spu_loop_detection.get(),
+			g_cfg.core.spu_prof.get(),
+			g_cfg.core.spu_accurate_reservations.get(),
+			g_cfg.core.spu_accurate_dma.get(),
+			static_cast<u64>(g_cfg.core.rsx_fifo_accuracy.get()),
+			g_cfg.core.rsx_accurate_res_access.get(),
+			g_cfg.core.mfc_debug.get(),
+			static_cast<u64>(g_cfg.core.clocks_scale.get()),
+			exe_stat.size,
+			static_cast<u64>(exe_stat.mtime),
+		};
+
+		sha1_context ctx;
+		u8 output[20];
+
+		sha1_starts(&ctx);
+		sha1_update(&ctx, reinterpret_cast<const u8*>(settings), sizeof(settings));
+		sha1_finish(&ctx, output);
+
+		// Version, settings hash, CPU
+		const std::string dir = cache_path + fmt::format("spu-%s-v1-obj-%s-%s/", fmt::to_lower(g_cfg.core.spu_block_size.to_string()), fmt::base57(output, 8), jit_compiler::cpu(g_cfg.core.llvm_cpu));
+
+		if (!fs::create_path(dir) || !symbol_file.open(dir + "symbols.dat", fs::read + fs::write + fs::create + fs::append))
+		{
+			spu_log.error("SPU LLVM: Failed to initialize object cache at: %s (%s)", dir, fs::g_tls_error);
+			return;
+		}
+
+		const std::vector<u8> data = symbol_file.to_vector<u8>();
+
+		usz pos = 0;
+
+		// Each record: name size (u16), name, offset from the anchor (s64)
+		while (pos + 2 <= data.size())
+		{
+			const u16 size = read_from_ptr<be_t<u16>>(data, pos);
+
+			if (pos + 2 + size + 8 > data.size())
+			{
+				break;
+			}
+
+			const s64 offset = read_from_ptr<be_t<s64>>(data, pos + 2 + size);
+
+			symbols.emplace(std::string(reinterpret_cast<const char*>(data.data() + pos + 2), size), anchor() + offset);
+
+			pos += 2 + size + 8;
+		}
+
+		if (pos != data.size())
+		{
+			// Remove incomplete record
+			symbol_file.trunc(pos);
+		}
+
+		path = dir;
+	}
+
+	u64 find(const std::string& name)
+	{
+		reader_lock lock(mutex);
+
+		const auto found = symbols.find(name);
+		return found != symbols.end() ? found->second : 0;
+	}
+
+	void add(const std::string& name, u64 addr)
+	{
+		std::lock_guard lock(mutex);
+
+		if (!symbols.emplace(name, addr).second)
+		{
+			return;
+		}
+
+		const be_t<u16> size = ::narrow<u16>(name.size());
+		const be_t<s64> offset = static_cast<s64>(addr - anchor());
+
+		const fs::iovec_clone gather[3]
+		{
+			{&size, sizeof(size)},
+			{name.data(), name.size()},
+			{&offset, sizeof(offset)}
+		};
+
+		symbol_file.write_gather(gather, 3);
+	}
+};
+
 class spu_llvm_recompiler : public spu_recompiler_base, public cpu_translator
 {
-	// JIT Instance
-	jit_compiler m_jit{{}, jit_compiler::cpu(g_cfg.core.llvm_cpu)};
+	// JIT Instance (symbols of loaded objects are resolved by resolve_object_symbol)
+	jit_compiler m_jit{{}, jit_compiler::cpu(g_cfg.core.llvm_cpu), 0, [this](const std::string& name) { return resolve_object_symbol(name); }};
+
+	// Set if the module being built can be stored in the object cache
+	bool m_relocatable = true;
 
 	// Interpreter table size power
 	const u8 m_interp_magn;
@@ -1551,6 +1728,41 @@ public:
 			m_hash_start = hash_start;
 		}
 
+		auto& objects = g_fxo->get<spu_llvm_object_cache>();
+
+		if (!objects.path.empty())
+		{
+			if (const auto fn = load_object(objects.path + m_hash + ".obj"))
+			{
+				add_loc->compiled = fn;
+
+				if (!m_spurt->rebuild_ubertrampoline(func.data[0]))
+				{
+					return nullptr;
+				}
+
+				add_loc->compiled.notify_all();
+
+#if defined(__APPLE__)
+				pthread_jit_write_protect_np(true);
+#endif
+#if defined(ARCH_ARM64)
+				// Flush all cache lines after potentially writing executable code
+				asm("ISB");
+				asm("DSB ISH");
+#endif
+
+				if (auto& cache = g_fxo->get<spu_cache>(); cache && add_to_file)
+				{
+					cache.add(func);
+				}
+
+				return fn;
+			}
+		}
+
+		m_relocatable = true;
+
 		spu_log.notice("Building function 0x%x... (size %u, %s)", func.entry_point, func.data.size(), m_hash);
 
 		m_pos = func.lower_bound;
@@ -2776,6 +2988,10 @@ public:
 			// Testing only
 			m_jit.add(std::move(_module), m_spurt->get_cache_path() + "llvm/");
 		}
+		else if (!objects.path.empty() && register_object_symbols(objects))
+		{
+			m_jit.add(std::move(_module), objects.path);
+		}
 		else
 		{
 			m_jit.add(std::move(_module));
@@ -2865,6 +3081,118 @@ public:
 		}
 	}
 
+	// Load object built by a previous session
+	spu_function_t load_object(const std::string& path)
+	{
+		if (!fs::is_file(path + ".gz"))
+		{
+			return nullptr;
+		}
+
+#if defined(__APPLE__)
+		pthread_jit_write_protect_np(false);
+#endif
+
+		// Refused before it is added to the engine, the program is then built under the same name
+		if (!m_jit.add(path, [this](const std::string& name) { return name.starts_with(m_hash) || find_object_symbol(name); }))
+		{
+			fs::remove_file(path + ".gz");
+			return nullptr;
+		}
+
+		m_jit.fin();
+
+		const auto fn = reinterpret_cast<spu_function_t>(m_jit.get(m_hash));
+
+		if (!fn)
+		{
+			// Not defined by the object, the name is still free
+			spu_log.error("SPU LLVM: Object %s doesn't define the program", m_hash);
+			fs::remove_file(path + ".gz");
+			return nullptr;
+		}
+
+		spu_log.trace("SPU LLVM: Loaded object %s", m_hash);
+		return fn;
+	}
+
+	// Resolve external symbol of the object (called by the JIT if not mapped)
+	u64 resolve_object_symbol(const std::string& name)
+	{
+		if (name.starts_with(m_hash))
+		{
+			// Branch patchpoints are unique for each object
+			return reinterpret_cast<u64>(m_spurt->make_branch_patchpoint());
+		}
+
+		return find_object_symbol(name);
+	}
+
+	static u64 find_object_symbol(const std::string& name)
+	{
+		if (const u64 addr = spu_llvm_object_cache::get_runtime_symbol(name))
+		{
+			return addr;
+		}
+
+		return g_fxo->get<spu_llvm_object_cache>().find(name);
+	}
+
+	// Save external symbols of the module, return false if it cannot be stored in the object cache
+	bool register_object_symbols(spu_llvm_object_cache& objects)
+	{
+		if (!m_relocatable)
+		{
+			return false;
+		}
+
+		std::vector<const llvm::GlobalValue*> externals;
+
+		for (const auto& f : *m_module)
+		{
+			if (f.isDeclaration() && !f.isIntrinsic())
+			{
+				externals.push_back(&f);
+			}
+		}
+
+		for (const auto& g : m_module->globals())
+		{
+			if (g.isDeclaration())
+			{
+				externals.push_back(&g);
+			}
+		}
+
+		for (const llvm::GlobalValue* value : externals)
+		{
+			const std::string name = value->getName().str();
+
+			if (name.starts_with(m_hash) || spu_llvm_object_cache::get_runtime_symbol(name))
+			{
+				continue;
+			}
+
+			const u64 addr = m_engine->getAddressToGlobalIfAvailable(name);
+
+			if (!addr)
+			{
+				continue;
+			}
+
+			if (!spu_llvm_object_cache::is_image_address(addr))
+			{
+				// Only stored as an offset from the anchor: unknown symbol in JIT memory or another module
+				spu_log.notice("SPU LLVM: Object of %s is not cached (external symbol %s)", m_hash, name);
+				return false;
+			}
+
+			objects.add(name, addr);
+		}
+
+		return true;
+	}
+
 	spu_function_t compile_interpreter()
 	{
 		using namespace llvm;
@@ -3504,6 +3832,9 @@ public:
 #if defined(ARCH_X64)
 			if (utils::get_tsc_freq() && !(g_cfg.core.spu_loop_detection) && (g_cfg.core.clocks_scale == 100))
 			{
+				// Embeds host-specific constants
+				m_relocatable = false;
+
 				const auto timebase_offs = m_ir->CreateLoad(get_type<u64>(), m_ir->CreateIntToPtr(m_ir->getInt64(reinterpret_cast<u64>(&g_timebase_offs)), get_type<u64*>()));
 				const auto timestamp = m_ir->CreateLoad(get_type<u64>(), spu_ptr(&spu_thread::ch_dec_start_timestamp));
 				const auto dec_value = m_ir->CreateLoad(get_type<u32>(), spu_ptr(&spu_thread::ch_dec_value));
@@ -4327,6 +4658,9 @@ public:
 #if defined(ARCH_X64)
 			if (utils::get_tsc_freq() && !(g_cfg.core.spu_loop_detection) && (g_cfg.core.clocks_scale == 100))
 			{
+				// Embeds host-specific constants
+				m_relocatable = false;
+
 				const auto timebase_offs = m_ir->CreateLoad(get_type<u64>(), m_ir->CreateIntToPtr(m_ir->getInt64(reinterpret_cast<u64>(&g_timebase_offs)), get_type<u64*>()));
 				const auto tsc = m_ir->CreateCall(get_intrinsic(llvm::Intrinsic::x86_rdtsc));
 				const auto tscx = m_ir->CreateMul(m_ir->CreateUDiv(tsc, m_ir->getInt64(utils::get_tsc_freq())), m_ir->getInt64(80000000));
@@ -437,6 +437,9 @@ public:
 	// Print analyser internal state
 	void dump(const spu_program& result, std::string& out);
 
+	// Queue the function for background recompilation with LLVM (its entry must start with a patchable 8-byte instruction)
+	static void tier_up(u64 hash_start, spu_item* item);
+
 	// Get SPU Runtime
 	spu_runtime& get_runtime()
 	{
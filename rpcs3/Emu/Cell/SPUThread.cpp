@@ -462,6 +462,11 @@ waitpkg_func static void __tpause(u32 cycles, u32 cstate)
 namespace vm
 {
 	std::array<atomic_t<reservation_waiter_t>, 2048> g_resrv_waiters_count{};
+
+	bool g_resrv_exact_waiters = false;
+
+	atomic_t<u64> g_resrv_waiter_wakeups = 0;
+	atomic_t<u64> g_resrv_waiter_spurious = 0;
 }
 
 void do_cell_atomic_128_store(u32 addr, const void* to_write);
@@ -4927,7 +4932,7 @@ bool spu_thread::process_mfc_cmd()
 						if (auto [wait_var, flag_val] = vm::reservation_notifier_begin_wait(addr, rtime); wait_var)
 						{
 							cache_line_waiter_index = register_cache_line_waiter(addr);
-							utils::bless<atomic_t<u32>>(&wait_var->raw().wait_flag)->wait(flag_val, atomic_wait_timeout{100'000});
+							vm::reservation_notifier_wait(*wait_var, flag_val, addr, rtime, 100'000);
 							vm::reservation_notifier_end_wait(*wait_var);
 						}
 
@@ -6335,7 +6340,7 @@ s64 spu_thread::get_ch_value(u32 ch)
 							}
 							else if (check_cache_line_waiter())
 							{
-								utils::bless<atomic_t<u32>>(&wait_var->raw().wait_flag)->wait(flag_val, atomic_wait_timeout{200'000});
+								vm::reservation_notifier_wait(*wait_var, flag_val, raddr, rtime, 200'000);
 							}
 
 							vm::reservation_notifier_end_wait(*wait_var);
@@ -6355,7 +6360,7 @@ s64 spu_thread::get_ch_value(u32 ch)
 						}
 						else if (check_cache_line_waiter())
 						{
-							utils::bless<atomic_t<u32>>(&wait_var->raw().wait_flag)->wait(flag_val, atomic_wait_timeout{50'000});
+							vm::reservation_notifier_wait(*wait_var, flag_val, _raddr, rtime, 50'000);
 						}
 
 						vm::reservation_notifier_end_wait(*wait_var);
@@ -6436,7 +6441,7 @@ s64 spu_thread::get_ch_value(u32 ch)
 						else if (check_cache_line_waiter())
 						{
 							atomic_wait_engine::set_one_time_use_wait_callback(wait_cb);
-							utils::bless<atomic_t<u32>>(&wait_var->raw().wait_flag)->wait(flag_val, atomic_wait_timeout{100'000});
+							vm::reservation_notifier_wait(*wait_var, flag_val, _raddr, rtime, 100'000);
 						}
 
 						vm::reservation_notifier_end_wait(*wait_var);
@@ -385,6 +385,7 @@ u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size, u64 opt
 	if (u64 region = buf.addr() >> 28, region_end = (buf.addr() & 0xfff'ffff) + (size & 0xfff'ffff); region == region_end && ((region >> 28) == 0 || region >= 0xC))
 	{
 		// Optimize reads from safe memory
+		vm::load_lazy_memory(buf.addr(), static_cast<u32>(std::min<u64>(size, u32{umax})));
 		return (opt_pos == umax ? file.read(buf.get_ptr(), size) : file.read_at(opt_pos, buf.get_ptr(), size));
 	}
 
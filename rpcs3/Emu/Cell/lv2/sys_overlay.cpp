@@ -16,6 +16,8 @@
 extern std::pair<shared_ptr<lv2_overlay>, CellError> ppu_load_overlay(const ppu_exec_object&, bool virtual_load, const std::string& path, s64 file_offset, utils::serial* ar = nullptr);
 
 extern bool ppu_initialize(const ppu_module<lv2_obj>&, bool check_only = false, u64 file_size = 0);
+extern void ppu_initialize_in_background(shared_ptr<ppu_module<lv2_obj>> info);
+extern void ppu_cancel_background_initialize(const ppu_module<lv2_obj>& info);
 extern void ppu_finalize(const ppu_module<lv2_obj>& info, bool force_mem_release = false);
 
 LOG_CHANNEL(sys_overlay);
@@ -66,7 +68,7 @@ static error_code overlay_load_module(vm::ptr<u32> ovlmid, const std::string& vp
 		return error;
 	}
 
-	ppu_initialize(*ovlm);
+	ppu_initialize_in_background(ovlm);
 
 	sys_overlay.success("Loaded overlay: \"%s\" (id=0x%x)", vpath, idm::last_id());
 
@@ -193,6 +195,8 @@ error_code sys_overlay_unload_module(u32 ovlmid)
 		return CELL_ESRCH;
 	}
 
+	ppu_cancel_background_initialize(*_main);
+
 	for (auto& seg : _main->segs)
 	{
 		vm::dealloc(seg.addr);
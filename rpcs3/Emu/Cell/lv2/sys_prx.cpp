@@ -22,6 +22,8 @@ extern void dump_executable(std::span<const u8> data, const ppu_module<lv2_obj>*
 extern shared_ptr<lv2_prx> ppu_load_prx(const ppu_prx_object&, bool virtual_load, const std::string&, s64, utils::serial* = nullptr);
 extern void ppu_unload_prx(const lv2_prx& prx);
 extern bool ppu_initialize(const ppu_module<lv2_obj>&, bool check_only = false, u64 file_size = 0);
+extern void ppu_initialize_in_background(shared_ptr<ppu_module<lv2_obj>> info);
+extern void ppu_cancel_background_initialize(const ppu_module<lv2_obj>& info);
 extern void ppu_finalize(const ppu_module<lv2_obj>& info, bool force_mem_release = false);
 extern void ppu_manual_load_imports_exports(u32 imports_start, u32 imports_size, u32 exports_start, u32 exports_size, std::basic_string<char>& loaded_flags);
 
@@ -296,7 +298,7 @@ static error_code prx_load_module(const std::string& vpath, u64 flags, vm::ptr<s
 		return CELL_PRX_ERROR_ILLEGAL_LIBRARY;
 	}
 
-	ppu_initialize(*prx);
+	ppu_initialize_in_background(prx);
 
 	sys_prx.success("Loaded module: \"%s\" (id=0x%x)", vpath, idm::last_id());
 
@@ -745,6 +747,8 @@ error_code _sys_prx_unload_module(ppu_thread& ppu, u32 id, u64 flags, vm::ptr<sy
 
 	prx->mutex.lock_unlock();
 
+	ppu_cancel_background_initialize(*prx);
+
 	ppu_unload_prx(*prx);
 
 	ppu_finalize(*prx);
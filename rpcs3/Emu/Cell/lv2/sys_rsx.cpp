@@ -433,6 +433,9 @@ error_code sys_rsx_context_iomap(cpu_thread& cpu, u32 context_id, u32 io, u32 ea
 		}
 	}
 
+	// RSX accesses mapped memory through host mappings, restore lazily loaded savestate memory first
+	vm::load_lazy_memory(ea, size);
+
 	io >>= 20, ea >>= 20, size >>= 20;
 
 	rsx::eng_lock fifo_lock(render);
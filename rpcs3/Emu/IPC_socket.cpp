@@ -47,6 +47,16 @@ namespace IPC_socket
 		vm::write64(addr, value);
 	}
 
+	void IPC_impl::read_bytes(u32 addr, char* dst, u32 size)
+	{
+		std::memcpy(dst, vm::base(addr), size);
+	}
+
+	void IPC_impl::write_bytes(u32 addr, const char* src, u32 size)
+	{
+		std::memcpy(vm::base(addr), src, size);
+	}
+
 	int IPC_impl::get_port()
 	{
 		return g_cfg_ipc.get_port();
@@ -18,6 +18,11 @@ namespace IPC_socket
 			return vm::check_addr<Size>(addr, flags);
 		}
 
+		static bool check_range(u32 addr, u32 size, u8 flags = vm::page_readable)
+		{
+			return size == 0 || vm::check_addr(addr, flags, size);
+		}
+
 		static const u8& read8(u32 addr);
 		static void write8(u32 addr, u8 value);
 		static const be_t<u16>& read16(u32 addr);
@@ -26,6 +31,8 @@ namespace IPC_socket
 		static void write32(u32 addr, be_t<u32> value);
 		static const be_t<u64>& read64(u32 addr);
 		static void write64(u32 addr, be_t<u64> value);
+		static void read_bytes(u32 addr, char* dst, u32 size);
+		static void write_bytes(u32 addr, const char* src, u32 size);
 
 		template<typename... Args>
 		static void error(const const_str& fmt, Args&&... args)
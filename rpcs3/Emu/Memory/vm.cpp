@@ -10,6 +10,8 @@
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/Cell/SPURecompiler.h"
 #include "Emu/perf_meter.hpp"
+#include "Emu/savestate_utils.hpp"
+#include <bit>
 #include <deque>
 #include <span>
 
@@ -598,6 +600,49 @@ namespace vm
 
 	atomic_t<u32>* reservation_notifier_notify(u32 raddr, u64 rtime, bool postpone)
 	{
+		if (g_resrv_exact_waiters)
+		{
+			// Wake every slot of this cache line (there is usually one)
+			const u32 tag = raddr & -128;
+
+			atomic_t<u32>* result = nullptr;
+
+			for (u32 i = 0; i < rsrv_waiter_max_probe; i++)
+			{
+				auto& waiter = reservation_notifier_slot(raddr, i);
+
+				if (const auto value = waiter.load(); value.wait_flag % 2 == 0 || value.waiters_count % 128 == 0 || (value.waiters_count & -128) != tag)
+				{
+					continue;
+				}
+
+				if (!waiter.fetch_op([&](reservation_waiter_t& value)
+				{
+					if (value.wait_flag % 2 == 1 && value.waiters_count % 128 && (value.waiters_count & -128) == tag)
+					{
+						// Notify and make it even
+						value.wait_flag++;
+						return true;
+					}
+
+					return false;
+				}).second)
+				{
+					continue;
+				}
+
+				if (postpone && !result)
+				{
+					result = utils::bless<atomic_t<u32>>(&waiter.raw().wait_flag);
+					continue;
+				}
+
+				utils::bless<atomic_t<u32>>(&waiter.raw().wait_flag)->notify_all();
+			}
+
+			return result;
+		}
+
 		const auto waiter = reservation_notifier(raddr, rtime);
 
 		if (waiter->load().wait_flag % 2 == 1)
@@ -877,6 +922,9 @@ namespace vm
 
 		vm::writer_lock lock;
 
+		// Memory protection is restored from page flags when loaded
+		load_lazy_memory(addr, size);
+
 		if (!size || (size | addr) % 4096)
 		{
 			fmt::throw_exception("Invalid arguments (addr=0x%x, size=0x%x)", addr, size);
@@ -950,6 +998,8 @@ namespace vm
 		return true;
 	}
 
+	static void _discard_lazy_memory(u32 addr, u32 size);
+
 	static u32 _page_unmap(u32 addr, u32 max_size, u64 bflags, utils::shm* shm, std::vector<std::pair<u64, u64>>& unmap_events)
 	{
 		perf_meter<"PAGE_UNm"_u64> perf0;
@@ -986,6 +1036,8 @@ namespace vm
 			size += 4096;
 		}
 
+		_discard_lazy_memory(addr, size);
+
 		// Protect range locks from actual memory protection changes
 		auto range_lock = _lock_main_range_lock(range_allocation, addr, size);
 
@@ -1651,10 +1703,513 @@ namespace vm
 		return gv_testz(_7);
 	}
 
+	// Savestate memory which is restored on first access (lazy savestate loading)
+	struct lazy_memory_range
+	{
+		u32 addr;
+		u32 size;
+		std::vector<u8> bitmap; // Non-zero 128-byte lines, as serialized
+		std::vector<usz> chunk_pos; // Serialized data position of each chunk
+		std::unique_ptr<atomic_t<u8>[]> pending; // Chunks which have not been loaded yet (2 if requested by a faulting thread)
+	};
+
+	struct lazy_memory_t
+	{
+		static constexpr u32 chunk_size = 0x10000;
+
+		shared_mutex mutex;
+		std::shared_ptr<utils::serial> source;
+		std::map<u32, lazy_memory_range> ranges;
+		std::vector<u8> buffer;
+		atomic_t<usz> pending = 0;
+		atomic_t<u32> requests = 0; // Chunks requested by faulting threads
+		atomic_t<u32> loaded = 0; // Incremented and notified whenever chunks are loaded
+		atomic_t<bool> active = false;
+		std::unique_ptr<named_thread<std::function<void()>>> loader_thread;
+	};
+
+	static lazy_memory_t g_lazy_memory;
+
+	// Restore main memory protection according to page flags
+	static void _restore_page_protection(u32 addr, u32 size)
+	{
+		for (u32 i = addr / 4096, end = (addr + size) / 4096; i < end;)
+		{
+			const u8 flags = g_pages[i];
+
+			u32 j = i + 1;
+
+			while (j < end && g_pages[j] == flags)
+			{
+				j++;
+			}
+
+			auto prot = utils::protection::rw;
+			if (~flags & page_writable)
+				prot = utils::protection::ro;
+			if (~flags & page_readable || ~flags & page_allocated)
+				prot = utils::protection::no;
+
+			utils::memory_protect(g_base_addr + i * 4096, (j - i) * 4096, prot);
+			i = j;
+		}
+	}
+
+	// Load a chunk of lazily restored memory (mutex must be locked)
+	static void _load_lazy_chunk(lazy_memory_range& range, usz index)
+	{
+		if (!range.pending[index])
+		{
+			return;
+		}
+
+		const u32 offset = ::narrow<u32>(index * lazy_memory_t::chunk_size);
+		const u32 size = std::min<u32>(lazy_memory_t::chunk_size, range.size - offset);
+		const u8* bitmap = range.bitmap.data() + offset / 1024;
+		u8* const dst = g_sudo_addr + range.addr + offset;
+
+		usz line_count = 0;
+
+		for (u32 i = 0; i < size / 1024; i++)
+		{
+			line_count += std::popcount(bitmap[i]);
+		}
+
+		auto& buffer = g_lazy_memory.buffer;
+		buffer.resize(line_count * 128);
+
+		auto& ar = *g_lazy_memory.source;
+		ar.seek_pos(range.chunk_pos[index], true);
+		ar(std::span<u8>(buffer.data(), buffer.size()));
+
+		utils::memory_protect(dst, size, utils::protection::rw);
+
+		const u8* src = buffer.data();
+
+		for (u32 i = 0; i < size / 128; i++)
+		{
+			if (bitmap[i / 8] & (1u << (i % 8)))
+			{
+				std::memcpy(dst + i * 128, src, 128);
+				src += 128;
+			}
+		}
+
+		// Memory RSX can access is never deferred, so there are no texture cache protections to preserve here
+		_restore_page_protection(range.addr + offset, size);
+
+		range.pending[index].release(0);
+		g_lazy_memory.pending--;
+		g_lazy_memory.loaded++;
+		g_lazy_memory.loaded.notify_all();
+	}
+
+	// Apply func to each pending chunk overlapping the range (mutex must be locked)
+	template <typename F>
+	static void _for_each_lazy_chunk(u32 addr, u32 size, F&& func)
+	{
+		auto it = g_lazy_memory.ranges.upper_bound(addr);
+
+		if (it != g_lazy_memory.ranges.begin())
+		{
+			it--;
+		}
+
+		for (; it != g_lazy_memory.ranges.end() && it->first < addr + u64{size}; it++)
+		{
+			auto& range = it->second;
+
+			if (range.addr + u64{range.size} <= addr)
+			{
+				continue;
+			}
+
+			const u32 start = std::max(addr, range.addr) - range.addr;
+			const u32 end = static_cast<u32>(std::min<u64>(addr + u64{size}, range.addr + u64{range.size}) - range.addr);
+
+			for (usz i = start / lazy_memory_t::chunk_size; i < utils::aligned_div(end, lazy_memory_t::chunk_size); i++)
+			{
+				if (range.pending[i])
+				{
+					func(range, i);
+				}
+			}
+		}
+	}
+
+	void load_lazy_memory(u32 addr, u32 size)
+	{
+		if (!g_lazy_memory.pending || !size)
+		{
+			return;
+		}
+
+		std::lock_guard lock(g_lazy_memory.mutex);
+
+		_for_each_lazy_chunk(addr, size, [](lazy_memory_range& range, usz index)
+		{
+			_load_lazy_chunk(range, index);
+		});
+	}
+
+	// Forget lazily restored memory which is being unmapped
+	static void _discard_lazy_memory(u32 addr, u32 size)
+	{
+		if (!g_lazy_memory.pending)
+		{
+			return;
+		}
+
+		std::lock_guard lock(g_lazy_memory.mutex);
+
+		_for_each_lazy_chunk(addr, size, [&](lazy_memory_range& range, usz index)
+		{
+			const u32 chunk_addr = range.addr + ::narrow<u32>(index * lazy_memory_t::chunk_size);
+			const u32 chunk_size = std::min<u32>(lazy_memory_t::chunk_size, range.addr + range.size - chunk_addr);
+
+			if (chunk_addr < addr || chunk_addr + u64{chunk_size} > addr + u64{size})
+			{
+				// Partially unmapped
+				_load_lazy_chunk(range, index);
+				return;
+			}
+
+			utils::memory_protect(g_sudo_addr + chunk_addr, chunk_size, utils::protection::rw);
+			range.pending[index].release(0);
+			g_lazy_memory.pending--;
+			g_lazy_memory.loaded++;
+			g_lazy_memory.loaded.notify_all();
+		});
+	}
+
+	bool try_load_lazy_memory(const void* ptr)
+	{
+		if (!g_lazy_memory.active)
+		{
+			return false;
+		}
+
+		// Both the main and the sudo mappings are protected
+		const usz base_diff = static_cast<const u8*>(ptr) - g_base_addr;
+		const usz sudo_diff = static_cast<const u8*>(ptr) - g_sudo_addr;
+
+		if (base_diff > u32{umax} && sudo_diff > u32{umax})
+		{
+			return false;
+		}
+
+		const u32 addr = static_cast<u32>(base_diff <= u32{umax} ? base_diff : sudo_diff);
+
+		// Address of the last fault which was not caused by unloaded memory
+		thread_local u32 s_tls_retry_addr = 0;
+
+		atomic_t<u8>* state = nullptr;
+		{
+			reader_lock lock(g_lazy_memory.mutex);
+
+			auto it = g_lazy_memory.ranges.upper_bound(addr);
+
+			if (it == g_lazy_memory.ranges.begin())
+			{
+				return false;
+			}
+
+			auto& range = std::prev(it)->second;
+
+			if (addr - range.addr >= range.size)
+			{
+				return false;
+			}
+
+			state = &range.pending[(addr - range.addr) / lazy_memory_t::chunk_size];
+		}
+
+		if (!*state)
+		{
+			// The chunk may have been loaded by another thread after the fault occurred, retry once
+			if (std::exchange(s_tls_retry_addr, addr) != addr)
+			{
+				return true;
+			}
+
+			s_tls_retry_addr = 0;
+			return false;
+		}
+
+		// Only wait in the handler: the chunk is decompressed by the loader thread
+		if (state->compare_and_swap_test(1, 2))
+		{
+			g_lazy_memory.requests++;
+		}
+
+		while (true)
+		{
+			const u32 loaded = g_lazy_memory.loaded;
+
+			if (!*state)
+			{
+				break;
+			}
+
+			if (!g_lazy_memory.active)
+			{
+				// The loader has been stopped
+				return false;
+			}
+
+			g_lazy_memory.loaded.wait(loaded);
+		}
+
+		s_tls_retry_addr = 0;
+		return true;
+	}
+
+	static void _reset_lazy_memory()
+	{
+		// Join the loader thread
+		g_lazy_memory.loader_thread.reset();
+
+		std::lock_guard lock(g_lazy_memory.mutex);
+
+		for (auto& [addr, range] : g_lazy_memory.ranges)
+		{
+			for (usz i = 0; i < range.chunk_pos.size(); i++)
+			{
+				if (range.pending[i])
+				{
+					const u32 offset = ::narrow<u32>(i * lazy_memory_t::chunk_size);
+					utils::memory_protect(g_sudo_addr + range.addr + offset, std::min<u32>(lazy_memory_t::chunk_size, range.size - offset), utils::protection::rw);
+				}
+			}
+		}
+
+		g_lazy_memory.ranges.clear();
+		g_lazy_memory.buffer = {};
+		g_lazy_memory.source.reset();
+		g_lazy_memory.pending = 0;
+		g_lazy_memory.requests = 0;
+		g_lazy_memory.active = false;
+	}
+
+	// Skip memory of a preallocated block allocation and register it for loading on access
+	static bool _try_defer_memory_bytes(utils::serial& ar, u32 addr, u32 size, u64 bflags)
+	{
+		if (!g_lazy_memory.source || GET_SERIALIZATION_VERSION(vm) || !ar.m_file_handler || !ar.m_file_handler->is_random_access())
+		{
+			return false;
+		}
+
+		if ((addr | size) % lazy_memory_t::chunk_size || bflags & (stack_guarded | page_size_4k))
+		{
+			return false;
+		}
+
+		if (addr + u64{size} > 0x4000'0000)
+		{
+			// RSX context and video memory are accessed by RSX through host mappings (texture cache protection, DMA imports)
+			return false;
+		}
+
+		lazy_memory_range range{addr, size};
+		range.bitmap.resize(size / 1024);
+		ar(std::span<u8>(range.bitmap.data(), range.bitmap.size()));
+
+		const usz chunk_count = size / lazy_memory_t::chunk_size;
+		range.chunk_pos.resize(chunk_count);
+		range.pending = std::make_unique<atomic_t<u8>[]>(chunk_count);
+
+		usz pos = ar.pos;
+		usz pending = 0;
+
+		for (usz i = 0; i < chunk_count; i++)
+		{
+			usz line_count = 0;
+
+			for (usz j = 0; j < lazy_memory_t::chunk_size / 1024; j++)
+			{
+				line_count += std::popcount(range.bitmap[i * (lazy_memory_t::chunk_size / 1024) + j]);
+			}
+
+			range.chunk_pos[i] = pos;
+			pos += line_count * 128;
+
+			if (line_count)
+			{
+				// Make memory inaccessible until it is loaded (zero chunks are already restored)
+				const u32 chunk_addr = addr + ::narrow<u32>(i * lazy_memory_t::chunk_size);
+				utils::memory_protect(g_base_addr + chunk_addr, lazy_memory_t::chunk_size, utils::protection::no);
+				utils::memory_protect(g_sudo_addr + chunk_addr, lazy_memory_t::chunk_size, utils::protection::no);
+				range.pending[i].raw() = 1;
+				pending++;
+			}
+		}
+
+		ar.seek_pos(pos, true);
+
+		if (pending)
+		{
+			std::lock_guard lock(g_lazy_memory.mutex);
+			g_lazy_memory.ranges.emplace(addr, std::move(range));
+			g_lazy_memory.pending += pending;
+			g_lazy_memory.active = true;
+		}
+
+		return true;
+	}
+
+	// Load chunks requested by faulting threads (mutex must be locked)
+	static void _load_requested_lazy_chunks()
+	{
+		if (!g_lazy_memory.requests.exchange(0))
+		{
+			return;
+		}
+
+		for (auto& [addr, range] : g_lazy_memory.ranges)
+		{
+			for (usz i = 0; i < range.chunk_pos.size(); i++)
+			{
+				if (range.pending[i] == 2)
+				{
+					_load_lazy_chunk(range, i);
+				}
+			}
+		}
+	}
+
+	static void _start_lazy_memory_loader()
+	{
+		if (!g_lazy_memory.pending)
+		{
+			g_lazy_memory.source.reset();
+			return;
+		}
+
+		vm_log.notice("Savestate memory is loaded on access (chunks=%u)", +g_lazy_memory.pending);
+
+		// Load the rest of the memory in the background, chunks requested by the access violation handler first
+		g_lazy_memory.loader_thread = std::make_unique<named_thread<std::function<void()>>>("Savestate Memory Loader"sv, []()
+		{
+			const u64 start_time = get_system_time();
+
+			for (u32 addr = 0; g_lazy_memory.pending && thread_ctrl::state() != thread_state::aborting;)
+			{
+				std::lock_guard lock(g_lazy_memory.mutex);
+
+				_load_requested_lazy_chunks();
+
+				auto it = g_lazy_memory.ranges.lower_bound(addr);
+
+				if (it == g_lazy_memory.ranges.end())
+				{
+					break;
+				}
+
+				auto& range = it->second;
+
+				// Load a few chunks at a time in order to not stall faulting threads for long
+				usz i = 0;
+
+				for (usz count = 0; i < range.chunk_pos.size() && count < 16 && !g_lazy_memory.requests; i++)
+				{
+					if (range.pending[i])
+					{
+						_load_lazy_chunk(range, i);
+						count++;
+					}
+				}
+
+				if (i == range.chunk_pos.size())
+				{
+					addr = range.addr + range.size;
+				}
+			}
+
+			if (thread_ctrl::state() != thread_state::aborting)
+			{
+				vm_log.success("Savestate memory has been loaded in the background (time=%gs)", (get_system_time() - start_time) / 1000000.);
+
+				// Give threads which faulted before the last chunk was loaded time to enter the handler
+				thread_ctrl::wait_for(100'000);
+			}
+
+			// Wake up threads waiting in the access violation handler
+			g_lazy_memory.active = false;
+			g_lazy_memory.loaded++;
+			g_lazy_memory.loaded.notify_all();
+		});
+	}
+
+	// Delta savestates: memory is kept in the page pool, only chunk hashes are serialized
+	static void serialize_memory_chunks(utils::serial& ar, u8* ptr, usz size)
+	{
+		const auto pool = get_savestate_page_pool();
+
+		if (!pool)
+		{
+			fmt::throw_exception("Savestate page pool is not set (ar=%s)", ar);
+		}
+
+		for (usz iter_count = 0; size; iter_count++)
+		{
+			const usz chunk_size = std::min<usz>(size, savestate_page_pool::chunk_size);
+
+			u8 is_stored = 0;
+			savestate_page_pool::hash_t hash{};
+
+			if (ar.is_writing())
+			{
+				for (usz i = 0; i < chunk_size; i += 128)
+				{
+					if (!check_cache_line_zero(ptr + i))
+					{
+						is_stored = 1;
+						break;
+					}
+				}
+
+				if (is_stored)
+				{
+					hash = savestate_page_pool::hash(ptr, chunk_size);
+					pool->store(hash, ptr, chunk_size);
+				}
+			}
+
+			ar(is_stored);
+
+			if (is_stored)
+			{
+				ar(hash);
+
+				// Zero chunks are skipped, memory is zero-initialized
+				if (!ar.is_writing() && !pool->load(hash, ptr, chunk_size))
+				{
+					fmt::throw_exception("Memory chunk is missing in savestate page pool (ar=%s)", ar);
+				}
+			}
+
+			ptr += chunk_size;
+			size -= chunk_size;
+
+			if (iter_count % 256 == 0)
+			{
+				ar.breathe();
+			}
+		}
+
+		ar.breathe();
+	}
+
 	static void serialize_memory_bytes(utils::serial& ar, u8* ptr, usz size)
 	{
 		ensure((size % 4096) == 0);
 
+		if (ar.is_writing() ? !!get_savestate_page_pool() : GET_SERIALIZATION_VERSION(vm) != 0)
+		{
+			serialize_memory_chunks(ar, ptr, size);
+			return;
+		}
+
 		constexpr usz byte_of_pages = 128 * 8;
 
 		std::vector<u8> bit_array(size / byte_of_pages);
@@ -1829,7 +2384,7 @@ namespace vm
 			// Copy the shared handle unconditionally
 			ensure(try_alloc(addr0, pflags, size0, ::as_rvalue(flags & preallocated ? null_shm : shared[ar.pop<usz>()])));
 
-			if (flags & preallocated)
+			if (flags & preallocated && !_try_defer_memory_bytes(ar, addr0, size0, flags))
 			{
 				// Load binary image
 				const u32 guard_size = flags & stack_guarded ? 0x1000 : 0;
@@ -2239,6 +2794,8 @@ namespace vm
 
 	void close()
 	{
+		_reset_lazy_memory();
+
 		{
 			vm::writer_lock lock;
 
@@ -2330,8 +2887,11 @@ namespace vm
 		is_memory_compatible_for_copy_from_executable_optimization(0, 0); // Cleanup internal data
 	}
 
-	void load(utils::serial& ar)
+	void load(utils::serial& ar, std::shared_ptr<utils::serial> lazy_source)
 	{
+		_reset_lazy_memory();
+		g_lazy_memory.source = std::move(lazy_source);
+
 		std::vector<std::shared_ptr<utils::shm>> shared;
 
 		const usz shared_size = ar.pop<usz>();
@@ -2373,6 +2933,8 @@ namespace vm
 				loc = std::make_shared<block_t>(ar, shared);
 			}
 		}
+
+		_start_lazy_memory_loader();
 	}
 
 	u32 get_shm_addr(const std::shared_ptr<utils::shm>& shared)
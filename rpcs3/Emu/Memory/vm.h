@@ -359,9 +359,17 @@ namespace vm
 
 	void close();
 
-	void load(utils::serial& ar);
+	// Memory of preallocated main memory blocks may be restored on first access if lazy_source is set (reader of the same savestate)
+	void load(utils::serial& ar, std::shared_ptr<utils::serial> lazy_source = nullptr);
 	void save(utils::serial& ar);
 
+	// Ensure lazily restored savestate memory in range is loaded (before passing it to native APIs)
+	void load_lazy_memory(u32 addr, u32 size);
+
+	// Access violation handler hook, returns true if the fault was caused by memory that was not loaded yet
+	// Only waits for the loader thread to restore it (no decompression in the handler)
+	bool try_load_lazy_memory(const void* ptr);
+
 	// Returns sample address for shared memory, 0 on failure (wraps block_t::get_shm_addr)
 	u32 get_shm_addr(const std::shared_ptr<utils::shm>& shared);
 
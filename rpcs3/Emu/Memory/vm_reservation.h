@@ -4,6 +4,7 @@
 #include "vm_locking.h"
 #include "util/atomic.hpp"
 #include "util/tsc.hpp"
+#include "util/bless.hpp"
 #include <functional>
 
 extern bool g_use_rtm;
@@ -43,64 +44,174 @@ namespace vm
 		u32 waiters_count = 0;
 	};
 
+	extern std::array<atomic_t<reservation_waiter_t>, 2048> g_resrv_waiters_count;
+
+	// Use exact per-cache-line notifier slots instead of the hashed ones
+	// In this mode waiters_count holds the cache line address in the upper bits and the count in the low 7 bits
+	extern bool g_resrv_exact_waiters;
+
+	// Notifier wakeup statistics (spurious: the reservation didn't change)
+	extern atomic_t<u64> g_resrv_waiter_wakeups;
+	extern atomic_t<u64> g_resrv_waiter_spurious;
+
+	enum : u32
+	{
+		rsrv_waiter_count_mask = 127,
+		rsrv_waiter_max_probe = 8,
+	};
+
 	static inline atomic_t<reservation_waiter_t>* reservation_notifier(u32 raddr, u64 rtime)
 	{
-		constexpr u32 wait_vars_for_each = 64;
 		constexpr u32 unique_address_bit_mask = 0b1111;
 		constexpr u32 unique_rtime_bit_mask = 0b1;
 
-		extern std::array<atomic_t<reservation_waiter_t>, wait_vars_for_each * (unique_address_bit_mask + 1) * (unique_rtime_bit_mask + 1)> g_resrv_waiters_count;
-
 		// Storage efficient method to distinguish different nearby addresses (which are likely)
 		const usz index = std::popcount(raddr & -2048) * (1 << 5) + ((rtime / 128) & unique_rtime_bit_mask) * (1 << 4) + ((raddr / 128) & unique_address_bit_mask);
 		return &g_resrv_waiters_count[index];
 	}
 
+	// Exact mode: slot probed for a cache line (Fibonacci hashing of the line index)
+	static inline atomic_t<reservation_waiter_t>& reservation_notifier_slot(u32 raddr, u32 probe)
+	{
+		const u32 start = ((raddr / 128) * 0x9E3779B9u) >> 21;
+		return g_resrv_waiters_count[(start + probe) % g_resrv_waiters_count.size()];
+	}
+
 	// Returns waiter count
 	static inline u32 reservation_notifier_count(u32 raddr, u64 rtime)
 	{
-		return reservation_notifier(raddr, rtime)->load().waiters_count;
+		if (!g_resrv_exact_waiters)
+		{
+			return reservation_notifier(raddr, rtime)->load().waiters_count;
+		}
+
+		u32 count = 0;
+
+		for (u32 i = 0; i < rsrv_waiter_max_probe; i++)
+		{
+			const u32 value = reservation_notifier_slot(raddr, i).load().waiters_count;
+
+			if (value % 128 && (value & -128) == (raddr & -128))
+			{
+				count += value % 128;
+			}
+		}
+
+		return count;
 	}
 
 	static inline void reservation_notifier_end_wait(atomic_t<reservation_waiter_t>& waiter)
 	{
 		waiter.atomic_op([](reservation_waiter_t& value)
 		{
-			if (value.waiters_count == 1 && value.wait_flag % 2 == 1)
+			const u32 count = g_resrv_exact_waiters ? value.waiters_count % 128 : value.waiters_count;
+
+			if (count == 1 && value.wait_flag % 2 == 1)
 			{
 				// Make wait_flag even (disabling notification on last waiter)
 				value.wait_flag++;
 			}
 
 			value.waiters_count--;
+
+			if (g_resrv_exact_waiters && value.waiters_count % 128 == 0)
+			{
+				// Release the slot
+				value.waiters_count = 0;
+			}
 		});
 	}
 
 	static inline std::pair<atomic_t<reservation_waiter_t>*, u32> reservation_notifier_begin_wait(u32 raddr, u64 rtime)
 	{
-		atomic_t<reservation_waiter_t>& waiter = *reservation_notifier(raddr, rtime);
+		atomic_t<reservation_waiter_t>* waiter = nullptr;
 
 		u32 wait_flag = 0;
 
-		waiter.atomic_op([&](reservation_waiter_t& value)
+		if (!g_resrv_exact_waiters)
 		{
-			if (value.wait_flag % 2 == 0)
+			waiter = reservation_notifier(raddr, rtime);
+
+			waiter->atomic_op([&](reservation_waiter_t& value)
 			{
-				// Make wait_flag odd (for notification deduplication detection)
-				value.wait_flag++;
+				if (value.wait_flag % 2 == 0)
+				{
+					// Make wait_flag odd (for notification deduplication detection)
+					value.wait_flag++;
+				}
+
+				wait_flag = value.wait_flag;
+				value.waiters_count++;
+			});
+		}
+		else
+		{
+			const u32 tag = raddr & -128;
+
+			for (u32 i = 0; i < rsrv_waiter_max_probe && !waiter; i++)
+			{
+				atomic_t<reservation_waiter_t>& slot = reservation_notifier_slot(raddr, i);
+
+				const bool ok = slot.atomic_op([&](reservation_waiter_t& value)
+				{
+					const u32 count = value.waiters_count % 128;
+
+					if (count == 0)
+					{
+						// Claim a free slot for this cache line
+						value.waiters_count = tag;
+					}
+					else if ((value.waiters_count & -128) != tag || count == rsrv_waiter_count_mask)
+					{
+						return false;
+					}
+
+					if (value.wait_flag % 2 == 0)
+					{
+						value.wait_flag++;
+					}
+
+					wait_flag = value.wait_flag;
+					value.waiters_count++;
+					return true;
+				});
+
+				if (ok)
+				{
+					waiter = &slot;
+				}
 			}
 
-			wait_flag = value.wait_flag;
-			value.waiters_count++;
-		});
+			if (!waiter)
+			{
+				// All probed slots are taken by other cache lines
+				return {};
+			}
+		}
 
 		if ((reservation_acquire(raddr) & -128) != rtime)
 		{
-			reservation_notifier_end_wait(waiter);
+			reservation_notifier_end_wait(*waiter);
 			return {};
 		}
 
-		return { &waiter, wait_flag };
+		return { waiter, wait_flag };
+	}
+
+	// Wait for a notification (or timeout), updating wakeup statistics
+	static inline void reservation_notifier_wait(atomic_t<reservation_waiter_t>& waiter, u32 wait_flag, u32 raddr, u64 rtime, u64 timeout)
+	{
+		utils::bless<atomic_t<u32>>(&waiter.raw().wait_flag)->wait(wait_flag, atomic_wait_timeout{timeout});
+
+		if (waiter.load().wait_flag != wait_flag)
+		{
+			g_resrv_waiter_wakeups++;
+
+			if ((reservation_acquire(raddr) & -128) == rtime)
+			{
+				g_resrv_waiter_spurious++;
+			}
+		}
 	}
 
 	atomic_t<u32>* reservation_notifier_notify(u32 raddr, u64 rtime, bool postpone = false);
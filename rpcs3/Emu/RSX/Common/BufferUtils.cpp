@@ -1,8 +1,10 @@
 #include "stdafx.h"
 #include "BufferUtils.h"
 #include "util/to_endian.hpp"
+#include "util/asm.hpp"
 #include "util/sysinfo.hpp"
 #include "Utilities/JIT.h"
+#include "Utilities/Thread.h"
 #include "util/v128.hpp"
 #include "util/simd.hpp"
 
@@ -204,6 +206,49 @@ namespace
 		return value;
 	}
 
+	// Split independent index processing across the shared worker pool for very large draws.
+	// func(first, last) processes src[first, last) and returns {min, max, written}.
+	// Chunks are aligned to granularity so that no primitive is split between workers.
+	template <typename T, typename F>
+	std::tuple<T, T, u32> process_indices_chunked(u32 count, u32 granularity, F&& func)
+	{
+		constexpr u32 min_indices_per_worker = 0x40000;
+
+		const u32 worker_count = std::min<u32>(thread_worker_pool::max_workers(), count / min_indices_per_worker);
+
+		if (worker_count <= 1)
+		{
+			return func(0, count);
+		}
+
+		const u32 chunk_size = utils::align(utils::aligned_div(count, worker_count), granularity);
+
+		std::vector<std::tuple<T, T, u32>> results(worker_count, std::make_tuple(index_limit<T>(), T{0}, 0u));
+
+		thread_worker_pool::run(worker_count, worker_count, [&](u32 chunk)
+		{
+			const u32 first = chunk * chunk_size;
+
+			if (first < count)
+			{
+				results[chunk] = func(first, std::min(first + chunk_size, count));
+			}
+		});
+
+		T min_index = index_limit<T>();
+		T max_index = 0;
+		u32 written = 0;
+
+		for (const auto& [min, max, n] : results)
+		{
+			min_index = std::min(min_index, min);
+			max_index = std::max(max_index, max);
+			written += n;
+		}
+
+		return std::make_tuple(min_index, max_index, written);
+	}
+
 	struct untouched_impl
 	{
 		template <typename T>
@@ -286,23 +331,22 @@ namespace
 		template <typename T>
 		static std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::span<T> dst)
 		{
-			T min_index, max_index;
-			u32 count = ::size32(src);
-			u64 r;
+			return process_indices_chunked<T>(::size32(src), 1, [&](u32 first, u32 last) -> std::tuple<T, T, u32>
+			{
+				const u32 count = last - first;
+				u64 r;
 
 #if defined(ARCH_X64)
-			if constexpr (sizeof(T) == 2)
-				r = upload_xi16(src.data(), dst.data(), count);
-			else
-				r = upload_xi32(src.data(), dst.data(), count);
+				if constexpr (sizeof(T) == 2)
+					r = upload_xi16(src.data() + first, dst.data() + first, count);
+				else
+					r = upload_xi32(src.data() + first, dst.data() + first, count);
 #else
-			r = upload_untouched_naive(src.data(), dst.data(), count);
+				r = upload_untouched_naive(src.data() + first, dst.data() + first, count);
 #endif
 
-			min_index = static_cast<T>(r);
-			max_index = static_cast<T>(r >> 32);
-
-			return std::make_tuple(min_index, max_index, count);
+				return std::make_tuple(static_cast<T>(r), static_cast<T>(r >> 32), count);
+			});
 		}
 	};
 
@@ -392,23 +436,23 @@ namespace
 		template <typename T>
 		static inline std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::span<T> dst, T restart_index)
 		{
-			T min_index, max_index;
-			u32 count = ::size32(src);
-			u64 r;
+			// Restart indices are rewritten in place, every element is independent
+			return process_indices_chunked<T>(::size32(src), 1, [&](u32 first, u32 last) -> std::tuple<T, T, u32>
+			{
+				const u32 count = last - first;
+				u64 r;
 
 #if defined(ARCH_X64)
-			if constexpr (sizeof(T) == 2)
-				r = upload_xi16(src.data(), dst.data(), count, restart_index);
-			else
-				r = upload_xi32(src.data(), dst.data(), count, restart_index);
+				if constexpr (sizeof(T) == 2)
+					r = upload_xi16(src.data() + first, dst.data() + first, count, restart_index);
+				else
+					r = upload_xi32(src.data() + first, dst.data() + first, count, restart_index);
 #else
-			r = upload_untouched_naive(src.data(), dst.data(), count, restart_index);
+				r = upload_untouched_naive(src.data() + first, dst.data() + first, count, restart_index);
 #endif
 
-			min_index = static_cast<T>(r);
-			max_index = static_cast<T>(r >> 32);
-
-			return std::make_tuple(min_index, max_index, count);
+				return std::make_tuple(static_cast<T>(r), static_cast<T>(r >> 32), count);
+			});
 		}
 	};
 
@@ -470,7 +514,7 @@ namespace
 		for (; (i + step) <= count; i += step, vec_ptr++)
 		{
 			_mm_stream_si128(vec_ptr, values);
-			_mm_add_epi16(values,  vec_step);
+			values = _mm_add_epi16(values, vec_step);
 		}
 #endif
 		for (; i < count; ++i)
@@ -712,7 +756,16 @@ namespace
 		}
 		case rsx::primitive_type::quads:
 		{
-			return expand_indexed_quads<T>(src, dst, restart_index_enabled, restart_index);
+			if (restart_index_enabled)
+			{
+				return expand_indexed_quads<T>(src, dst, true, restart_index);
+			}
+
+			// Without restart every group of 4 indices maps to 6 outputs at a fixed position
+			return process_indices_chunked<T>(::size32(src), 4, [&](u32 first, u32 last)
+			{
+				return expand_indexed_quads<T>(src.subspan(first, last - first), dst.subspan(first / 4 * 6), false, 0);
+			});
 		}
 		default:
 			fmt::throw_exception("Unknown draw mode (0x%x)", static_cast<u8>(draw_mode));
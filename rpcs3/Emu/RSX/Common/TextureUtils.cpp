@@ -4,8 +4,11 @@
 #include "../RSXThread.h"
 #include "../rsx_utils.h"
 #include "3rdparty/bcdec/bcdec.hpp"
+#include "Utilities/Thread.h"
 
 #include "util/asm.hpp"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
 
 namespace utils
 {
@@ -25,6 +28,30 @@ namespace utils
 namespace
 {
 
+// Run func(first_row, end_row) over all rows, splitting large images across the shared worker pool
+template <typename F>
+void process_rows(u32 row_count, usz bytes_per_row, F&& func)
+{
+	// Splitting is only worth it for a few MB of output per worker
+	constexpr usz min_bytes_per_worker = 0x200000;
+
+	const u32 worker_count = static_cast<u32>(std::min<usz>({thread_worker_pool::max_workers(), row_count * bytes_per_row / min_bytes_per_worker, row_count}));
+
+	if (worker_count <= 1)
+	{
+		func(0, row_count);
+		return;
+	}
+
+	const u32 rows_per_job = utils::aligned_div(row_count, worker_count * 4);
+
+	thread_worker_pool::run(utils::aligned_div(row_count, rows_per_job), worker_count, [&](u32 job)
+	{
+		const u32 begin = job * rows_per_job;
+		func(begin, std::min(begin + rows_per_job, row_count));
+	});
+}
+
 #ifndef __APPLE__
 u16 convert_rgb655_to_rgb565(const u16 bits)
 {
@@ -32,6 +59,28 @@ u16 convert_rgb655_to_rgb565(const u16 bits)
 	// r5 = (((bits & 0xFC00) >> 1) & 0xFC00) << 1 is equivalent to truncating the least significant bit
 	return (bits & 0xF81F) | (bits & 0x3E0) << 1;
 }
+
+template <typename T>
+void convert_rgb655_to_rgb565_row(u16* dst, const T* src, u32 count)
+{
+	u32 i = 0;
+
+	if constexpr (std::is_same_v<T, be_t<u16>>)
+	{
+		// 8 texels at a time, including the byteswap
+		for (; i + 8 <= count; i += 8)
+		{
+			const v128 data = v128::loadu(src + i);
+			const v128 bits = gv_or32(gv_shl16(data, 8), gv_shr16(data, 8));
+			v128::storeu(gv_or32(gv_and32(bits, gv_bcst16(0xF81F)), gv_shl16(gv_and32(bits, gv_bcst16(0x3E0)), 1)), dst + i);
+		}
+	}
+
+	for (; i < count; i++)
+	{
+		dst[i] = convert_rgb655_to_rgb565(src[i]);
+	}
+}
 #else
 u32 convert_rgb565_to_bgra8(const u16 bits)
 {
@@ -456,10 +505,7 @@ struct copy_rgb655_block
 
 			for (u32 row = 0; row < row_count; ++row)
 			{
-				for (int col = 0; col < width_in_block; ++col)
-				{
-					dst[dst_offset + col] = convert_rgb655_to_rgb565(src[src_offset + col + border]);
-				}
+				convert_rgb655_to_rgb565_row(&dst[dst_offset], &src[src_offset + border], width_in_block);
 
 				src_offset += src_pitch_in_block;
 				dst_offset += dst_pitch_in_block;
@@ -502,19 +548,25 @@ struct copy_decoded_bc1_block
 {
 	static void copy_mipmap_level(std::span<u32> dst, std::span<const u64> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
-		u32 src_offset = 0, dst_offset = 0, destinationPitch = dst_pitch_in_block * 4;
-		for (u32 row = 0; row < row_count * depth; row++)
+		const u32 destinationPitch = dst_pitch_in_block * 4;
+
+		// Each block decodes to 4x4 texels of 4 bytes
+		process_rows(row_count * depth, width_in_block * 64, [&](u32 first_row, u32 end_row)
 		{
-			for (u32 col = 0; col < width_in_block; col++)
+			u32 src_offset = first_row * src_pitch_in_block, dst_offset = first_row * destinationPitch;
+			for (u32 row = first_row; row < end_row; row++)
 			{
-				const u8* compressedBlock = reinterpret_cast<const u8*>(&src[src_offset + col]);
-				u8* decompressedBlock = reinterpret_cast<u8*>(&dst[dst_offset + col * 4]);
-				bcdec_bc1(compressedBlock, decompressedBlock, destinationPitch);
-			}
+				for (u32 col = 0; col < width_in_block; col++)
+				{
+					const u8* compressedBlock = reinterpret_cast<const u8*>(&src[src_offset + col]);
+					u8* decompressedBlock = reinterpret_cast<u8*>(&dst[dst_offset + col * 4]);
+					bcdec_bc1(compressedBlock, decompressedBlock, destinationPitch);
+				}
 
-			src_offset += src_pitch_in_block;
-			dst_offset += destinationPitch;
-		}
+				src_offset += src_pitch_in_block;
+				dst_offset += destinationPitch;
+			}
+		});
 	}
 };
 
@@ -522,19 +574,25 @@ struct copy_decoded_bc2_block
 {
 	static void copy_mipmap_level(std::span<u32> dst, std::span<const u128> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
-		u32 src_offset = 0, dst_offset = 0, destinationPitch = dst_pitch_in_block * 4;
-		for (u32 row = 0; row < row_count * depth; row++)
+		const u32 destinationPitch = dst_pitch_in_block * 4;
+
+		// Each block decodes to 4x4 texels of 4 bytes
+		process_rows(row_count * depth, width_in_block * 64, [&](u32 first_row, u32 end_row)
 		{
-			for (u32 col = 0; col < width_in_block; col++)
+			u32 src_offset = first_row * src_pitch_in_block, dst_offset = first_row * destinationPitch;
+			for (u32 row = first_row; row < end_row; row++)
 			{
-				const u8* compressedBlock = reinterpret_cast<const u8*>(&src[src_offset + col]);
-				u8* decompressedBlock = reinterpret_cast<u8*>(&dst[dst_offset + col * 4]);
-				bcdec_bc2(compressedBlock, decompressedBlock, destinationPitch);
-			}
+				for (u32 col = 0; col < width_in_block; col++)
+				{
+					const u8* compressedBlock = reinterpret_cast<const u8*>(&src[src_offset + col]);
+					u8* decompressedBlock = reinterpret_cast<u8*>(&dst[dst_offset + col * 4]);
+					bcdec_bc2(compressedBlock, decompressedBlock, destinationPitch);
+				}
 
-			src_offset += src_pitch_in_block;
-			dst_offset += destinationPitch;
-		}
+				src_offset += src_pitch_in_block;
+				dst_offset += destinationPitch;
+			}
+		});
 	}
 };
 
@@ -542,19 +600,25 @@ struct copy_decoded_bc3_block
 {
 	static void copy_mipmap_level(std::span<u32> dst, std::span<const u128> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
-		u32 src_offset = 0, dst_offset = 0, destinationPitch = dst_pitch_in_block * 4;
-		for (u32 row = 0; row < row_count * depth; row++)
+		const u32 destinationPitch = dst_pitch_in_block * 4;
+
+		// Each block decodes to 4x4 texels of 4 bytes
+		process_rows(row_count * depth, width_in_block * 64, [&](u32 first_row, u32 end_row)
 		{
-			for (u32 col = 0; col < width_in_block; col++)
+			u32 src_offset = first_row * src_pitch_in_block, dst_offset = first_row * destinationPitch;
+			for (u32 row = first_row; row < end_row; row++)
 			{
-				const u8* compressedBlock = reinterpret_cast<const u8*>(&src[src_offset + col]);
-				u8* decompressedBlock = reinterpret_cast<u8*>(&dst[dst_offset + col * 4]);
-				bcdec_bc3(compressedBlock, decompressedBlock, destinationPitch);
-			}
+				for (u32 col = 0; col < width_in_block; col++)
+				{
+					const u8* compressedBlock = reinterpret_cast<const u8*>(&src[src_offset + col]);
+					u8* decompressedBlock = reinterpret_cast<u8*>(&dst[dst_offset + col * 4]);
+					bcdec_bc3(compressedBlock, decompressedBlock, destinationPitch);
+				}
 
-			src_offset += src_pitch_in_block;
-			dst_offset += destinationPitch;
-		}
+				src_offset += src_pitch_in_block;
+				dst_offset += destinationPitch;
+			}
+		});
 	}
 };
 
@@ -240,21 +240,75 @@ namespace rsx
 		atomic_t<u32> unreleased_count = 0;
 		ranged_storage_type *m_storage = nullptr;
 
+		// Per-page reference counts of valid sections (owned and unowned) touching this block
+		// The bitmask mirrors non-zero counts and lets range lookups skip blocks without touching any section
+		static constexpr u32 pages_per_block = block_size / 4096;
+		static_assert(pages_per_block % 64 == 0, "block_size must span a multiple of 64 pages");
+
+		std::unique_ptr<u32[]> page_refs;
+		std::array<u64, pages_per_block / 64> page_mask{};
+
+		void update_page_refs(const address_range32 &section_range, bool add)
+		{
+			const address_range32 clipped = range.get_intersect(section_range);
+			if (!clipped.valid())
+			{
+				return;
+			}
+
+			if (!page_refs)
+			{
+				ensure(add);
+				page_refs = std::make_unique<u32[]>(pages_per_block);
+			}
+
+			const u32 first = (clipped.start - range.start) / 4096;
+			const u32 last = (clipped.end - range.start) / 4096;
+
+			for (u32 page = first; page <= last; ++page)
+			{
+				const u64 bit = 1ull << (page % 64);
+
+				if (add)
+				{
+					if (page_refs[page]++ == 0)
+					{
+						page_mask[page / 64] |= bit;
+					}
+				}
+				else
+				{
+					ensure(page_refs[page] > 0);
+
+					if (--page_refs[page] == 0)
+					{
+						page_mask[page / 64] &= ~bit;
+					}
+				}
+			}
+		}
+
 		inline void add_owned_section_overlaps(section_storage_type &section)
 		{
-			u32 end = section.get_section_range().end;
-			for (auto *block = next_block(); block != nullptr && end >= block->get_start(); block = block->next_block())
+			const auto& section_range = section.get_section_range();
+			update_page_refs(section_range, true);
+
+			for (auto *block = next_block(); block != nullptr && section_range.end >= block->get_start(); block = block->next_block())
 			{
 				block->add_unowned_section(section);
+				block->update_page_refs(section_range, true);
 			}
 		}
 
 		inline void remove_owned_section_overlaps(section_storage_type &section)
 		{
-			u32 end = section.get_section_range().end;
-			for (auto *block = next_block(); block != nullptr && end >= block->get_start(); block = block->next_block())
+			const auto& section_range = section.get_section_range();
+			update_page_refs(section_range, false);
+
+			for (auto *block = next_block(); block != nullptr && section_range.end >= block->get_start(); block = block->next_block())
 			{
 				block->remove_unowned_section(section);
+				block->update_page_refs(section_range, false);
 			}
 		}
 
@@ -321,6 +375,9 @@ namespace rsx
 			AUDIT(unreleased_count == 0);
 			AUDIT(locked_count == 0);
 			sections.clear();
+
+			page_refs.reset();
+			page_mask = {};
 		}
 
 		inline bool is_first_block() const
@@ -353,6 +410,41 @@ namespace rsx
 		inline bool overlaps(const section_storage_type& section, section_bounds bounds = full_range) const { return section.overlaps(range, bounds); }
 		inline bool overlaps(const address_range32& _range) const { return range.overlaps(_range); }
 
+		// Conservative check: returns false only if no valid section in this block touches any page of _range
+		bool test_page_overlap(const address_range32& _range) const
+		{
+			const address_range32 clipped = range.get_intersect(_range);
+			if (!clipped.valid())
+			{
+				return false;
+			}
+
+			const u32 first = (clipped.start - range.start) / 4096;
+			const u32 last = (clipped.end - range.start) / 4096;
+
+			for (u32 word = first / 64; word <= last / 64; ++word)
+			{
+				u64 mask = page_mask[word];
+
+				if (word == first / 64)
+				{
+					mask &= ~0ull << (first % 64);
+				}
+
+				if (word == last / 64)
+				{
+					mask &= ~0ull >> (63 - last % 64);
+				}
+
+				if (mask)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
 		/**
 		 * Section callbacks
 		 */
@@ -698,6 +790,13 @@ namespace rsx
 				, cur_block_it(block->begin())
 				, locked_only(_locked_only)
 			{
+				if (!block->test_page_overlap(range))
+				{
+					// Nothing in the first block touches the range, skip straight to the following blocks
+					unowned_remaining = false;
+					cur_block_it = block->end();
+				}
+
 				// do a "fake" iteration to ensure the internal state is consistent
 				next(false);
 			}
@@ -787,7 +886,7 @@ namespace rsx
 						needs_overlap_check = (block->get_end() > range.end);
 						cur_block_it = block->begin();
 						iterate = false;
-					} while (locked_only && block->get_locked_count() == 0); // find a block with locked sections
+					} while ((locked_only && block->get_locked_count() == 0) || !block->test_page_overlap(range)); // find a block with (locked) sections touching the range
 
 				} while (true);
 			}
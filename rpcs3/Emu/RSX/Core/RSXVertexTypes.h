@@ -173,5 +173,16 @@ namespace rsx
 
 			return mem;
 		}
+
+		// Identifies the guest memory ranges read by the interleaved blocks, i.e the contents of the persistent upload
+		void calculate_interleaved_ranges(u32 first_vertex, u32 vertex_count, rsx::simple_array<std::pair<u32, u32>>& ranges) const
+		{
+			ranges.clear();
+			for (auto& block : interleaved_blocks)
+			{
+				const auto range = block->calculate_required_range(first_vertex, vertex_count);
+				ranges.push_back({ block->real_offset_address + range.first * block->attribute_stride, range.second * block->attribute_stride });
+			}
+		}
 	};
 }
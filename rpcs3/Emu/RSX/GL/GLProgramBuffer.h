@@ -13,6 +13,9 @@ struct GLTraits
 	using pipeline_storage_type = std::unique_ptr<gl::glsl::program>;
 	using pipeline_properties = void*;
 
+	// Decompilation is cheap here, shader objects are compiled by the pipe compiler
+	static constexpr bool async_program_recompile = false;
+
 	static
 	void recompile_fragment_program(const RSXFragmentProgram &RSXFP, fragment_program_type& fragmentProgramData, usz /*ID*/)
 	{
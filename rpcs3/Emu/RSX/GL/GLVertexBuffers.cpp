@@ -188,6 +188,7 @@ gl::vertex_upload_info GLGSRender::set_vertex_buffer()
 		bool in_cache = false;
 		bool to_store = false;
 		u32  storage_address = -1;
+		rsx::simple_array<std::pair<u32, u32>> layout_ranges;
 
 		if (m_vertex_layout.interleaved_blocks.size() == 1 &&
 			rsx::method_registers.current_draw_clause.command != rsx::draw_command::inlined_array)
@@ -207,13 +208,33 @@ gl::vertex_upload_info GLGSRender::set_vertex_buffer()
 				to_store = true;
 			}
 		}
+		else if (m_vertex_layout.interleaved_blocks.size() > 1 &&
+			rsx::method_registers.current_draw_clause.command != rsx::draw_command::inlined_array)
+		{
+			// Separate streams, match on the combined source ranges instead
+			m_vertex_layout.calculate_interleaved_ranges(vertex_base, vertex_count, layout_ranges);
+
+			if (auto cached = m_vertex_cache->find_vertex_layout(layout_ranges, required.first))
+			{
+				in_cache = true;
+				upload_info.persistent_mapping_offset = cached->offset_in_heap;
+			}
+			else
+			{
+				to_store = true;
+			}
+		}
 
 		if (!in_cache)
 		{
 			persistent_mapping = m_attrib_ring_buffer->alloc_from_heap(required.first, m_min_texbuffer_alignment);
 			upload_info.persistent_mapping_offset = persistent_mapping.second;
 
-			if (to_store)
+			if (to_store && !layout_ranges.empty())
+			{
+				m_vertex_cache->store_layout(layout_ranges, required.first, persistent_mapping.second);
+			}
+			else if (to_store)
 			{
 				//store ref in vertex cache
 				m_vertex_cache->store_range(storage_address, required.first, persistent_mapping.second);
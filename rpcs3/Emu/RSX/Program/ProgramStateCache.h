@@ -11,6 +11,7 @@
 
 #include <span>
 #include <unordered_map>
+#include <unordered_set>
 
 enum class SHADER_TYPE
 {
@@ -204,6 +205,7 @@ protected:
 	shared_mutex m_fragment_mutex;
 	shared_mutex m_pipeline_mutex;
 	shared_mutex m_decompiler_mutex;
+	shared_mutex m_pending_mutex;
 
 	atomic_t<usz> m_next_id = 0;
 	bool m_cache_miss_flag; // Set if last lookup did not find any usable cached programs
@@ -212,6 +214,10 @@ protected:
 	binary_to_fragment_program m_fragment_shader_cache;
 	std::unordered_map<pipeline_key, pipeline_storage_type, pipeline_key_hash, pipeline_key_compare> m_storage;
 
+	// Hashes of programs being recompiled in the background. Their cache entries must not be used until removed from here.
+	std::unordered_set<usz> m_pending_vertex_programs;
+	std::unordered_set<usz> m_pending_fragment_programs;
+
 	decompiler_callback_t notify_pipeline_compiled;
 
 	vertex_program_type __null_vertex_program;
@@ -297,6 +303,77 @@ protected:
 		return std::forward_as_tuple(*new_shader, false);
 	}
 
+	/// Returns true if both programs are ready. Otherwise their recompilation is queued and the caller has to fall back for now.
+	bool prepare_programs_async(
+		rsx::program_cache_hint_t* cache_hint,
+		const RSXVertexProgram& vertex_shader,
+		const RSXFragmentProgram& fragment_shader,
+		const pipeline_properties& pipeline_properties,
+		bool allow_notification)
+	{
+		const bool has_vertex_hint = cache_hint && cache_hint->has_vertex_program();
+		const bool has_fragment_hint = cache_hint && cache_hint->has_fragment_program();
+
+		if (has_vertex_hint && has_fragment_hint)
+		{
+			return true;
+		}
+
+		const usz vp_hash = has_vertex_hint ? 0 : program_hash_util::vertex_program_storage_hash{}(vertex_shader);
+		const usz fp_hash = has_fragment_hint ? 0 : program_hash_util::fragment_program_storage_hash{}(fragment_shader);
+
+		{
+			reader_lock lock(m_pending_mutex);
+
+			if ((!has_vertex_hint && m_pending_vertex_programs.contains(vp_hash)) ||
+				(!has_fragment_hint && m_pending_fragment_programs.contains(fp_hash)))
+			{
+				// Still compiling
+				return false;
+			}
+		}
+
+		bool vp_missing = false, fp_missing = false;
+
+		if (!has_vertex_hint)
+		{
+			reader_lock lock(m_vertex_mutex);
+			vp_missing = !m_vertex_shader_cache.contains(vertex_shader);
+		}
+
+		if (!has_fragment_hint)
+		{
+			reader_lock lock(m_fragment_mutex);
+			fp_missing = !m_fragment_shader_cache.contains(fragment_shader);
+		}
+
+		if (!vp_missing && !fp_missing)
+		{
+			return true;
+		}
+
+		{
+			std::lock_guard lock(m_pending_mutex);
+
+			if (vp_missing) m_pending_vertex_programs.insert(vp_hash);
+			if (fp_missing) m_pending_fragment_programs.insert(fp_hash);
+		}
+
+		backend_traits::post_program_recompile([this, vertex_shader, fragment_shader_ = RSXFragmentProgram::clone(fragment_shader),
+			properties = pipeline_properties, allow_notification, vp_missing, fp_missing, vp_hash, fp_hash]() mutable
+		{
+			// Builds the programs and the pipeline inline on the worker
+			get_graphics_pipeline(nullptr, vertex_shader, fragment_shader_, properties, false, allow_notification);
+
+			std::lock_guard lock(m_pending_mutex);
+
+			if (vp_missing) m_pending_vertex_programs.erase(vp_hash);
+			if (fp_missing) m_pending_fragment_programs.erase(fp_hash);
+		});
+
+		return false;
+	}
+
 public:
 
 	struct program_buffer_patch_entry
@@ -357,6 +434,15 @@ public:
 		Args&& ...args
 	)
 	{
+		if constexpr (backend_traits::async_program_recompile && sizeof...(Args) == 0)
+		{
+			if (compile_async && !prepare_programs_async(cache_hint, vertex_shader, fragment_shader, pipeline_properties, allow_notification))
+			{
+				m_cache_miss_flag = true;
+				return { nullptr, nullptr, nullptr };
+			}
+		}
+
 		const auto& vp_search = search_vertex_program(cache_hint, vertex_shader);
 		const auto& fp_search = search_fragment_program(cache_hint, fragment_shader);
 
@@ -459,9 +545,11 @@ public:
 
 	void clear()
 	{
-		std::scoped_lock lock(m_vertex_mutex, m_fragment_mutex, m_decompiler_mutex, m_pipeline_mutex);
+		std::scoped_lock lock(m_vertex_mutex, m_fragment_mutex, m_decompiler_mutex, m_pipeline_mutex, m_pending_mutex);
 
 		notify_pipeline_compiled = {};
+		m_pending_vertex_programs.clear();
+		m_pending_fragment_programs.clear();
 		m_fragment_shader_cache.clear();
 		m_vertex_shader_cache.clear();
 		m_storage.clear();
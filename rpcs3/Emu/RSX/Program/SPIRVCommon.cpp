@@ -23,11 +23,201 @@
 
 #include "SPIRVCommon.h"
 #include "Emu/RSX/Program/GLSLTypes.h"
+#include "Emu/system_config.h"
+#include "Crypto/sha1.h"
+#include "Utilities/File.h"
+#include "Utilities/mutex.h"
+
+#include <unordered_map>
 
 namespace spirv
 {
 	static TBuiltInResource g_default_config;
 
+	// Bump when the compiler options below change
+	constexpr u32 spv_cache_version = 2;
+
+	// Compiled modules are shared by all titles and packed into a single file
+	// They are addressed by the hash of the source and compiler settings
+	class spv_cache
+	{
+		struct header_t
+		{
+			u64 magic;
+			u32 version;
+			s32 glslang_major;
+			s32 glslang_minor;
+			s32 glslang_patch;
+		};
+
+		struct record_t
+		{
+			u64 key[2];
+			u32 size;
+			u32 reserved;
+		};
+
+		struct entry_t
+		{
+			u64 key_hi;
+			u64 offset;
+			u32 size;
+		};
+
+		static constexpr u64 magic = "RPCS3SPV"_u64;
+
+		// The whole cache is discarded once it grows past this size
+		static constexpr u64 max_size = 64 * 1024 * 1024;
+
+		shared_mutex m_mutex;
+		bool m_init = false;
+		fs::file m_file;
+		std::unordered_map<u64, entry_t> m_index;
+
+		static header_t make_header()
+		{
+			const glslang::Version version = glslang::GetVersion();
+			return { magic, spv_cache_version, version.major, version.minor, version.patch };
+		}
+
+		void reset()
+		{
+			m_index.clear();
+			m_file.trunc(0);
+			m_file.seek(0);
+			m_file.write(make_header());
+		}
+
+		void init()
+		{
+			m_init = true;
+
+			const std::string path = fs::get_cache_dir() + "spirv/modules.pack";
+			fs::create_path(fs::get_parent_dir(path));
+
+			if (!m_file.open(path, fs::read + fs::write + fs::create))
+			{
+				rsx_log.error("SPIR-V cache: Failed to open '%s' (error=%s)", path, fs::g_tls_error);
+				return;
+			}
+
+			const header_t expected = make_header();
+			header_t header{};
+
+			if (!m_file.read(header) || std::memcmp(&header, &expected, sizeof(header)) != 0)
+			{
+				// Different compiler or cache version
+				reset();
+				return;
+			}
+
+			const u64 file_size = m_file.size();
+			u64 pos = sizeof(header_t);
+
+			for (record_t record{}; file_size - pos >= sizeof(record_t) && m_file.read(record) && record.size <= file_size - pos - sizeof(record_t);)
+			{
+				pos += sizeof(record_t);
+				m_index.insert_or_assign(record.key[0], entry_t{record.key[1], pos, record.size});
+				pos += record.size;
+				m_file.seek(pos);
+			}
+
+			if (pos != file_size)
+			{
+				// Incomplete append
+				m_file.trunc(pos);
+			}
+
+			m_file.seek(pos);
+		}
+
+	public:
+		static void get_key(u64 (&key)[2], const std::string& shader, ::glsl::program_domain domain, ::glsl::glsl_rules rules)
+		{
+			const u32 params[] = { static_cast<u32>(domain), static_cast<u32>(rules) };
+
+			sha1_context ctx;
+			u8 hash[20];
+
+			sha1_starts(&ctx);
+			sha1_update(&ctx, reinterpret_cast<const u8*>(params), sizeof(params));
+			sha1_update(&ctx, reinterpret_cast<const u8*>(shader.data()), shader.size());
+			sha1_finish(&ctx, hash);
+
+			std::memcpy(key, hash, sizeof(key));
+		}
+
+		bool load(const u64 (&key)[2], std::vector<u32>& spv)
+		{
+			{
+				reader_lock lock(m_mutex);
+
+				if (m_init)
+				{
+					return find(key, spv);
+				}
+			}
+
+			std::lock_guard lock(m_mutex);
+
+			if (!m_init)
+			{
+				init();
+			}
+
+			return find(key, spv);
+		}
+
+		void store(const u64 (&key)[2], const std::vector<u32>& spv)
+		{
+			std::lock_guard lock(m_mutex);
+
+			if (!m_file || m_index.contains(key[0]))
+			{
+				return;
+			}
+
+			const u32 size = ::size32(spv) * sizeof(u32);
+
+			if (m_file.size() + sizeof(record_t) + size > max_size)
+			{
+				rsx_log.notice("SPIR-V cache: Size limit reached, clearing the cache");
+				reset();
+			}
+
+			const u64 pos = m_file.seek(0, fs::seek_end);
+			m_file.write(record_t{{key[0], key[1]}, size, 0});
+			m_file.write(spv.data(), size);
+
+			m_index.emplace(key[0], entry_t{key[1], pos + sizeof(record_t), size});
+		}
+
+	private:
+		bool find(const u64 (&key)[2], std::vector<u32>& spv) const
+		{
+			const auto found = m_index.find(key[0]);
+
+			if (found == m_index.end() || found->second.key_hi != key[1])
+			{
+				return false;
+			}
+
+			const entry_t& entry = found->second;
+			std::vector<u32> result(entry.size / sizeof(u32));
+
+			// Check the SPIR-V magic in case the file was damaged
+			if (entry.size < 5 * sizeof(u32) || entry.size % sizeof(u32) || m_file.read_at(entry.offset, result.data(), entry.size) != entry.size || result[0] != 0x07230203)
+			{
+				return false;
+			}
+
+			spv = std::move(result);
+			return true;
+		}
+	};
+
+	static spv_cache g_spv_cache;
+
 	void init_default_resources(TBuiltInResource& rsc)
 	{
 		rsc.maxLights = 32;
@@ -127,6 +317,20 @@ namespace spirv
 
 	bool compile_glsl_to_spv(std::vector<u32>& spv, std::string& shader, ::glsl::program_domain domain, ::glsl::glsl_rules rules)
 	{
+		const bool use_cache = !g_cfg.video.disable_on_disk_shader_cache;
+
+		u64 cache_key[2]{};
+
+		if (use_cache)
+		{
+			spv_cache::get_key(cache_key, shader, domain, rules);
+
+			if (g_spv_cache.load(cache_key, spv))
+			{
+				return true;
+			}
+		}
+
 		EShLanguage lang = (domain == ::glsl::glsl_fragment_program)
 			? EShLangFragment
 			: (domain == ::glsl::glsl_vertex_program)
@@ -178,6 +382,11 @@ namespace spirv
 				//optimizer.RegisterPass(spvtools::CreateMergeReturnPass());        // Huge savings in vertex interpreter and likely normal vertex shaders
 				//optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());      // Remove dead code
 				//optimizer.Run(spv.data(), spv.size(), &spv);
+
+				if (use_cache && !spv.empty())
+				{
+					g_spv_cache.store(cache_key, spv);
+				}
 			}
 		}
 		else
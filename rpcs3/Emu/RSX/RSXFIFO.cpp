@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
 #include "Emu/System.h"
+#include "Emu/cache_utils.hpp"
 #include "RSXFIFO.h"
 #include "RSXThread.h"
 #include "Capture/rsx_capture.h"
@@ -480,9 +481,71 @@ namespace rsx
 		{
 			enabled = _enabled;
 			num_collapsed = 0;
+			num_elided = 0;
 			in_begin_end = false;
 		}
 
+		void flattening_helper::load_profile()
+		{
+			if (!g_cfg.video.fifo_reordering_profile)
+			{
+				return;
+			}
+
+			if (std::string cache_path = rpcs3::cache::get_ppu_cache(); !cache_path.empty())
+			{
+				m_profile_path = std::move(cache_path) + "fifo_profile.bin";
+			}
+			else
+			{
+				return;
+			}
+
+			if (fs::file f{m_profile_path})
+			{
+				profile_data data{};
+
+				if (!f.read(data) || data.magic != profile_data{}.magic || data.version != profile_data{}.version)
+				{
+					rsx_log.warning("Ignoring invalid FIFO profile '%s'", m_profile_path);
+					return;
+				}
+
+				m_profile = data;
+			}
+
+			if (m_profile.hint == application_not_compatible)
+			{
+				fifo_hint = application_not_compatible;
+			}
+			else if (m_profile.trials >= 4 && m_profile.frames_kept == 0)
+			{
+				// Every previous attempt was reverted, skip the first trial
+				fifo_hint = load_unoptimizable;
+			}
+
+			rsx_log.notice("Loaded FIFO profile (trials=%u, kept=%u, collapsed=%llu, elided=%llu)",
+				m_profile.trials, m_profile.frames_kept, m_profile.draws_collapsed, m_profile.writes_elided);
+		}
+
+		void flattening_helper::save_profile() const
+		{
+			if (m_profile_path.empty() || (!m_profile.trials && fifo_hint != application_not_compatible))
+			{
+				return;
+			}
+
+			profile_data data = m_profile;
+			data.hint = fifo_hint == application_not_compatible ? fifo_hint : unknown;
+
+			fs::pending_file f(m_profile_path);
+
+			if (!f.file || !f.file.write(data) || !f.commit())
+			{
+				rsx_log.error("Failed to save FIFO profile '%s' (%s)", m_profile_path, fs::g_tls_error);
+			}
+		}
+
 		void flattening_helper::force_disable()
 		{
 			if (enabled)
@@ -520,6 +583,9 @@ namespace rsx
 
 			if (enabled)
 			{
+				m_profile.draws_collapsed += num_collapsed;
+				m_profile.writes_elided += num_elided;
+
 				// Currently activated. Check if there is any benefit
 				if (num_collapsed < 500)
 				{
@@ -536,6 +602,11 @@ namespace rsx
 					fifo_hint = load_low;
 				}
 
+				if (enabled)
+				{
+					m_profile.frames_kept++;
+				}
+
 				reset(enabled);
 			}
 			else
@@ -549,11 +620,12 @@ namespace rsx
 					ensure(in_begin_end == false); // "Incorrect initial state"
 					ensure(num_collapsed == 0);
 					enabled = true;
+					m_profile.trials++;
 				}
 			}
 		}
 
-		flatten_op flattening_helper::test(register_pair& command)
+		flatten_op flattening_helper::test(register_pair& command, const rsx_state& state)
 		{
 			u32 flush_cmd = ~0u;
 			switch (const u32 reg = (command.reg >> 2))
@@ -611,6 +683,12 @@ namespace rsx
 						// Always ignore
 						command.reg = FIFO_DISABLED_COMMAND;
 					}
+					else if (!methods[reg] && state.test(reg, command.value))
+					{
+						// Plain state register rewritten with its current value, no observable effect
+						command.reg = FIFO_DISABLED_COMMAND;
+						num_elided++;
+					}
 					else
 					{
 						// Flush
@@ -849,7 +927,7 @@ namespace rsx
 
 			if (m_flattener.is_enabled()) [[unlikely]]
 			{
-				switch(m_flattener.test(command))
+				switch(m_flattener.test(command, *m_ctx->register_state))
 				{
 				case FIFO::NOTHING:
 				{
@@ -4,6 +4,7 @@
 #include "Emu/RSX/gcm_enums.h"
 
 #include <span>
+#include <string>
 
 struct RsxDmaControl;
 
@@ -11,6 +12,7 @@ namespace rsx
 {
 	class thread;
 	struct rsx_iomap_table;
+	struct rsx_state;
 
 	namespace FIFO
 	{
@@ -104,14 +106,30 @@ namespace rsx
 				return register_properties;
 			}();
 
+			// Per-title history of the flattener, used to skip trials that never paid off
+			struct profile_data
+			{
+				u64 magic = "RSXFLATP"_u64;
+				u32 version = 1;
+				u32 hint = unknown;
+				u32 trials = 0;         // Number of times flattening was switched on
+				u32 frames_kept = 0;    // Number of evaluations where it was worth keeping
+				u64 draws_collapsed = 0;
+				u64 writes_elided = 0;
+			};
+
 			u32 deferred_primitive = 0;
 			u32 draw_count = 0;
 			bool in_begin_end = false;
 
 			bool enabled = false;
 			u32  num_collapsed = 0;
+			u32  num_elided = 0;
 			optimization_hint fifo_hint = unknown;
 
+			profile_data m_profile{};
+			std::string m_profile_path;
+
 			void reset(bool _enabled);
 
 		public:
@@ -123,7 +141,10 @@ namespace rsx
 
 			void force_disable();
 			void evaluate_performance(u32 total_draw_count);
-			inline flatten_op test(register_pair& command);
+			inline flatten_op test(register_pair& command, const rsx_state& state);
+
+			void load_profile();
+			void save_profile() const;
 		};
 
 		class FIFO_control
@@ -10,6 +10,7 @@
 
 #include <thread>
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
 
 namespace rsx
 {
@@ -18,82 +19,178 @@ namespace rsx
 		lf_queue<transport_packet> m_work_queue;
 		atomic_t<u64> m_enqueued_count = 0;
 		atomic_t<u64> m_processed_count = 0;
+		atomic_t<u32> m_fence_waiters = 0; // Lanes blocked on a fence of this lane
 		transport_packet* m_current_job = nullptr;
 
 		thread_base* current_thread_ = nullptr;
+	};
 
-		void operator ()()
-		{
-			if (!g_cfg.video.multithreaded_rsx)
-			{
-				// Abort if disabled
-				return;
-			}
+	// Destination granularity of lane assignment, all writes to a region are processed in order
+	constexpr u32 lane_region_shift = 20;
 
-			current_thread_ = thread_ctrl::get_current();
-			ensure(current_thread_);
+	dma_manager::dma_manager() = default;
 
-			if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
-			{
-				thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
-			}
+	dma_manager::~dma_manager() = default;
 
-			while (thread_ctrl::state() != thread_state::aborting)
+	void dma_manager::run_lane(u32 index)
+	{
+		auto& lane = m_lanes[index];
+
+		lane.current_thread_ = thread_ctrl::get_current();
+		ensure(lane.current_thread_);
+
+		if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+		{
+			thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+		}
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			for (auto&& job : lane.m_work_queue.pop_all())
 			{
-				for (auto&& job : m_work_queue.pop_all())
+				// Wait for the packets this one is ordered after
+				for (u32 i = 0; i < m_lane_count; i++)
 				{
-					m_current_job = &job;
+					auto& other = m_lanes[i];
 
-					switch (job.type)
+					if (other.m_processed_count >= job.fence[i])
 					{
-					case raw_copy:
-					{
-						const u32 vm_addr = vm::try_get_addr(job.src).first;
-						rsx::reservation_lock<true, 1> rsx_lock(vm_addr, job.length, g_cfg.video.strict_rendering_mode && vm_addr);
-						std::memcpy(job.dst, job.src, job.length);
-						break;
-					}
-					case vector_copy:
-					{
-						std::memcpy(job.dst, job.opt_storage.data(), job.length);
-						break;
+						continue;
 					}
-					case index_emulate:
-					{
-						write_index_array_for_non_indexed_non_native_primitive_to_buffer(static_cast<char*>(job.dst), static_cast<rsx::primitive_type>(job.aux_param0), job.length);
-						break;
-					}
-					case callback:
+
+					other.m_fence_waiters++;
+
+					for (u64 processed = other.m_processed_count; processed < job.fence[i]; processed = other.m_processed_count)
 					{
-						rsx::get_current_renderer()->renderctl(job.aux_param0, job.src);
-						break;
-					}
-					default: fmt::throw_exception("Unreachable");
+						// The low half changes with every processed packet
+						utils::bless<atomic_t<u32>>(&other.m_processed_count)[0].wait(static_cast<u32>(processed));
 					}
 
-					m_processed_count.release(m_processed_count + 1);
+					other.m_fence_waiters--;
 				}
 
-				m_current_job = nullptr;
+				lane.m_current_job = &job;
 
-				if (m_enqueued_count.load() == m_processed_count.load())
+				switch (job.type)
 				{
-					m_processed_count.notify_all();
-					std::this_thread::yield();
+				case raw_copy:
+				{
+					const u32 vm_addr = vm::try_get_addr(job.src).first;
+					rsx::reservation_lock<true, 1> rsx_lock(vm_addr, job.length, g_cfg.video.strict_rendering_mode && vm_addr);
+					std::memcpy(job.dst, job.src, job.length);
+					break;
+				}
+				case vector_copy:
+				{
+					std::memcpy(job.dst, job.opt_storage.data(), job.length);
+					break;
+				}
+				case index_emulate:
+				{
+					write_index_array_for_non_indexed_non_native_primitive_to_buffer(static_cast<char*>(job.dst), static_cast<rsx::primitive_type>(job.aux_param0), job.length);
+					break;
+				}
+				case callback:
+				{
+					rsx::get_current_renderer()->renderctl(job.aux_param0, job.src);
+					break;
+				}
+				default: fmt::throw_exception("Unreachable");
+				}
+
+				lane.m_processed_count++;
+
+				if (lane.m_fence_waiters)
+				{
+					lane.m_processed_count.notify_all();
 				}
 			}
 
-			m_processed_count = -1;
-			m_processed_count.notify_all();
+			lane.m_current_job = nullptr;
+
+			if (lane.m_enqueued_count.load() == lane.m_processed_count.load())
+			{
+				lane.m_processed_count.notify_all();
+
+				if (index == 0)
+				{
+					// The main lane stays responsive
+					std::this_thread::yield();
+				}
+				else
+				{
+					thread_ctrl::wait_on(lane.m_work_queue);
+				}
+			}
 		}
 
-		static constexpr auto thread_name = "RSX Offloader"sv;
-	};
+		lane.m_processed_count = -1;
+		lane.m_processed_count.notify_all();
+	}
 
 	// initialization
 	void dma_manager::init()
 	{
-		m_thread = std::make_shared<named_thread<offload_thread>>();
+		m_lane_count = 1;
+		m_last_callback = 0;
+
+		if (!g_cfg.video.multithreaded_rsx)
+		{
+			m_lanes = std::make_unique<offload_thread[]>(1);
+			return;
+		}
+
+		// A second lane is only worth it with plenty of idle cores
+		m_lane_count = std::clamp<u32>(utils::get_thread_count() / 8, 1, max_lanes);
+		m_lanes = std::make_unique<offload_thread[]>(m_lane_count);
+
+		rsx_log.notice("RSX offloader: %u lanes", m_lane_count);
+
+		m_threads = std::make_shared<named_thread_group<std::function<void()>>>("RSX Offloader ", m_lane_count, std::function<void()>([this, next = std::make_shared<atomic_t<u32>>(0)]()
+		{
+			run_lane((*next)++);
+		}));
+	}
+
+	u32 dma_manager::get_lane(const void* dst) const
+	{
+		return static_cast<u32>((reinterpret_cast<uptr>(dst) >> lane_region_shift) % m_lane_count);
+	}
+
+	bool dma_manager::spans_regions(const void* dst, u32 length) const
+	{
+		const uptr start = reinterpret_cast<uptr>(dst);
+		return m_lane_count > 1 && length && (start >> lane_region_shift) != ((start + length - 1) >> lane_region_shift);
+	}
+
+	template <typename... Args>
+	void dma_manager::enqueue(u32 index, bool barrier, Args&&... args) const
+	{
+		std::lock_guard lock(m_enqueue_mutex);
+
+		fence_t fence{};
+
+		if (index != 0)
+		{
+			// Must not overtake callbacks queued earlier
+			fence[0] = m_last_callback;
+		}
+
+		if (barrier)
+		{
+			// Everything queued earlier on other lanes must complete first
+			ensure(index == 0);
+
+			for (u32 i = 1; i < m_lane_count; i++)
+			{
+				fence[i] = m_lanes[i].m_enqueued_count;
+			}
+
+			m_last_callback = m_lanes[0].m_enqueued_count + 1;
+		}
+
+		m_lanes[index].m_enqueued_count++;
+		m_lanes[index].m_work_queue.push(fence, std::forward<Args>(args)...);
 	}
 
 	// General transport
@@ -103,10 +200,14 @@ namespace rsx
 		{
 			std::memcpy(dst, src.data(), length);
 		}
+		else if (spans_regions(dst, length))
+		{
+			// Bytes owned by several lanes, order against all of them
+			enqueue(0, true, dst, src, length);
+		}
 		else
 		{
-			m_thread->m_enqueued_count++;
-			m_thread->m_work_queue.push(dst, src, length);
+			enqueue(get_lane(dst), false, dst, src, length);
 		}
 	}
 
@@ -117,11 +218,18 @@ namespace rsx
 			const u32 vm_addr = vm::try_get_addr(src).first;
 			rsx::reservation_lock<true, 1> rsx_lock(vm_addr, length, g_cfg.video.strict_rendering_mode && vm_addr);
 			std::memcpy(dst, src, length);
+			return;
 		}
-		else
+
+		// Split at region boundaries so that every byte is always written by the same lane
+		for (u32 offset = 0; offset < length;)
 		{
-			m_thread->m_enqueued_count++;
-			m_thread->m_work_queue.push(dst, src, length);
+			u8* const dst_ptr = static_cast<u8*>(dst) + offset;
+			const uptr region_end = ((reinterpret_cast<uptr>(dst_ptr) >> lane_region_shift) + 1) << lane_region_shift;
+			const u32 size = static_cast<u32>(std::min<uptr>(length - offset, region_end - reinterpret_cast<uptr>(dst_ptr)));
+
+			enqueue(get_lane(dst_ptr), false, static_cast<void*>(dst_ptr), static_cast<void*>(static_cast<u8*>(src) + offset), size);
+			offset += size;
 		}
 	}
 
@@ -133,10 +241,13 @@ namespace rsx
 			write_index_array_for_non_indexed_non_native_primitive_to_buffer(
 				static_cast<char*>(dst), primitive, count);
 		}
+		else if (spans_regions(dst, get_index_count(primitive, count) * sizeof(u16)))
+		{
+			enqueue(0, true, dst, primitive, count);
+		}
 		else
 		{
-			m_thread->m_enqueued_count++;
-			m_thread->m_work_queue.push(dst, primitive, count);
+			enqueue(get_lane(dst), false, dst, primitive, count);
 		}
 	}
 
@@ -145,8 +256,7 @@ namespace rsx
 	{
 		ensure(g_cfg.video.multithreaded_rsx);
 
-		m_thread->m_enqueued_count++;
-		m_thread->m_work_queue.push(request_code, args);
+		enqueue(0, true, request_code, args);
 	}
 
 	// Synchronization
@@ -154,7 +264,13 @@ namespace rsx
 	{
 		if (auto cpu = thread_ctrl::get_current())
 		{
-			return m_thread->current_thread_ == cpu;
+			for (u32 i = 0; i < m_lane_count; i++)
+			{
+				if (m_lanes[i].current_thread_ == cpu)
+				{
+					return true;
+				}
+			}
 		}
 
 		return false;
@@ -162,9 +278,20 @@ namespace rsx
 
 	bool dma_manager::sync() const
 	{
-		auto& _thr = *m_thread;
+		const auto is_busy = [this]()
+		{
+			for (u32 i = 0; i < m_lane_count; i++)
+			{
+				if (m_lanes[i].m_enqueued_count.load() > m_lanes[i].m_processed_count.load())
+				{
+					return true;
+				}
+			}
+
+			return false;
+		};
 
-		if (_thr.m_enqueued_count.load() <= _thr.m_processed_count.load()) [[likely]]
+		if (!is_busy()) [[likely]]
 		{
 			// Nothing to do
 			return true;
@@ -178,7 +305,7 @@ namespace rsx
 				return false;
 			}
 
-			while (_thr.m_enqueued_count.load() > _thr.m_processed_count.load())
+			while (is_busy())
 			{
 				rsxthr->on_semaphore_acquire_wait();
 				utils::pause();
@@ -186,7 +313,7 @@ namespace rsx
 		}
 		else
 		{
-			while (_thr.m_enqueued_count.load() > _thr.m_processed_count.load())
+			while (is_busy())
 				utils::pause();
 		}
 
@@ -196,12 +323,22 @@ namespace rsx
 	void dma_manager::join()
 	{
 		sync();
-		*m_thread = thread_state::aborting;
+
+		if (m_threads)
+		{
+			for (auto& thread : *m_threads)
+			{
+				thread = thread_state::aborting;
+			}
+		}
 	}
 
 	void dma_manager::set_mem_fault_flag()
 	{
 		ensure(is_current_thread()); // "Access denied"
+
+		// The renderer recovers from one lane fault at a time, other lanes wait here until it is done
+		m_fault_mutex.lock();
 		m_mem_fault_flag.release(true);
 	}
 
@@ -209,12 +346,23 @@ namespace rsx
 	{
 		ensure(is_current_thread()); // "Access denied"
 		m_mem_fault_flag.release(false);
+		m_fault_mutex.unlock();
 	}
 
 	// Fault recovery
 	utils::address_range32 dma_manager::get_fault_range(bool writing) const
 	{
-		const auto m_current_job = ensure(m_thread->m_current_job);
+		const transport_packet* m_current_job = nullptr;
+
+		for (u32 i = 0; i < m_lane_count; i++)
+		{
+			if (m_lanes[i].current_thread_ == thread_ctrl::get_current())
+			{
+				m_current_job = m_lanes[i].m_current_job;
+			}
+		}
+
+		ensure(m_current_job);
 
 		void *address = nullptr;
 		u32 range = m_current_job->length;
@@ -2,12 +2,15 @@
 
 #include "util/types.hpp"
 #include "Utilities/address_range.h"
+#include "Utilities/mutex.h"
 #include "gcm_enums.h"
 
+#include <array>
+#include <functional>
 #include <vector>
 
 template <typename T>
-class named_thread;
+class named_thread_group;
 
 namespace rsx
 {
@@ -21,6 +24,11 @@ namespace rsx
 			callback = 3
 		};
 
+		static constexpr u32 max_lanes = 4;
+
+		// Number of packets which must be processed on each lane before this one may run
+		using fence_t = std::array<u64, max_lanes>;
+
 		struct transport_packet
 		{
 			op type{};
@@ -30,21 +38,22 @@ namespace rsx
 			u32 length{};
 			u32 aux_param0{};
 			u32 aux_param1{};
+			fence_t fence{};
 
-			transport_packet(void *_dst, void *_src, u32 len)
-				: type(op::raw_copy), src(_src), dst(_dst), length(len)
+			transport_packet(const fence_t& _fence, void *_dst, void *_src, u32 len)
+				: type(op::raw_copy), src(_src), dst(_dst), length(len), fence(_fence)
 			{}
 
-			transport_packet(void *_dst, std::vector<u8>& _src, u32 len)
-				: type(op::vector_copy), opt_storage(std::move(_src)), dst(_dst), length(len)
+			transport_packet(const fence_t& _fence, void *_dst, std::vector<u8>& _src, u32 len)
+				: type(op::vector_copy), opt_storage(std::move(_src)), dst(_dst), length(len), fence(_fence)
 			{}
 
-			transport_packet(void *_dst, rsx::primitive_type prim, u32 len)
-				: type(op::index_emulate), dst(_dst), length(len), aux_param0(static_cast<u8>(prim))
+			transport_packet(const fence_t& _fence, void *_dst, rsx::primitive_type prim, u32 len)
+				: type(op::index_emulate), dst(_dst), length(len), aux_param0(static_cast<u8>(prim)), fence(_fence)
 			{}
 
-			transport_packet(u32 command, void* args)
-				: type(op::callback), src(args), aux_param0(command)
+			transport_packet(const fence_t& _fence, u32 command, void* args)
+				: type(op::callback), src(args), aux_param0(command), fence(_fence)
 			{}
 
 			transport_packet(const transport_packet&) = delete;
@@ -52,15 +61,33 @@ namespace rsx
 		};
 
 		atomic_t<bool> m_mem_fault_flag = false;
+		shared_mutex m_fault_mutex; // Held by the lane in fault recovery
 
+		// Packets are only ordered within a lane. Writes are assigned a lane by destination, callbacks always run on lane 0 and act as fences.
 		struct offload_thread;
-		std::shared_ptr<named_thread<offload_thread>> m_thread;
+		std::unique_ptr<offload_thread[]> m_lanes;
+		std::shared_ptr<named_thread_group<std::function<void()>>> m_threads;
+		u32 m_lane_count = 1;
+
+		mutable shared_mutex m_enqueue_mutex;
+		mutable u64 m_last_callback = 0; // Position of the last callback on lane 0
 
 		// TODO: Improved benchmarks here; value determined by profiling on a Ryzen CPU, rounded to the nearest 512 bytes
 		const u32 max_immediate_transfer_size = 3584;
 
+		u32 get_lane(const void* dst) const;
+
+		// Whether a write touches more than one lane region (such packets are queued as barriers)
+		bool spans_regions(const void* dst, u32 length) const;
+
+		template <typename... Args>
+		void enqueue(u32 lane, bool barrier, Args&&... args) const;
+
+		void run_lane(u32 lane);
+
 	public:
-		dma_manager() = default;
+		dma_manager();
+		~dma_manager();
 
 		// initialization
 		void init();
@@ -108,6 +108,9 @@ bool serialize<rsx::rsx_iomap_table>(utils::serial& ar, rsx::rsx_iomap_table& o)
 			if (addr != umax)
 			{
 				o.io[addr >> 20].raw() = static_cast<u32>(&ea_addr - o.ea.data()) << 20;
+
+				// Mapped memory is accessed through host mappings, it cannot be restored on access
+				vm::load_lazy_memory(addr, 0x100000);
 			}
 		}
 	}
@@ -942,6 +945,11 @@ namespace rsx
 
 		performance_counters.state = FIFO::state::empty;
 
+		if (!g_cfg.video.disable_FIFO_reordering)
+		{
+			m_flattener.load_profile();
+		}
+
 		const u64 event_flags = unsent_gcm_events.exchange(0);
 
 		if (Emu.IsStarting())
@@ -1137,6 +1145,8 @@ namespace rsx
 		// Deregister violation handler
 		g_access_violation_handler = nullptr;
 
+		m_flattener.save_profile();
+
 		// Clear any pending flush requests to release threads
 		std::this_thread::sleep_for(10ms);
 		do_local_task(rsx::FIFO::state::lock_wait);
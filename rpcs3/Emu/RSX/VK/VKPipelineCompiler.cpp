@@ -13,6 +13,10 @@ namespace vk
 	int g_num_pipe_compilers = 0;
 	atomic_t<int> g_compiler_index{};
 
+	// Driver pipeline cache shared by all compiler threads (access is internally synchronized by the driver)
+	VkPipelineCache g_pipeline_cache = VK_NULL_HANDLE;
+	std::string g_pipeline_cache_path;
+
 	pipe_compiler::pipe_compiler()
 	{
 		// TODO: Initialize workqueue
@@ -34,7 +38,11 @@ namespace vk
 		{
 			for (auto&& job : m_work_queue.pop_all())
 			{
-				if (job.is_graphics_job)
+				if (job.task_func)
+				{
+					job.task_func();
+				}
+				else if (job.is_graphics_job)
 				{
 					auto compiled = int_compile_graphics_pipe(job.graphics_data, job.graphics_modules, job.inputs, {}, job.flags);
 					job.callback_func(compiled);
@@ -216,6 +224,11 @@ namespace vk
 		return {};
 	}
 
+	void pipe_compiler::post(std::function<void()> task)
+	{
+		m_work_queue.push(std::move(task));
+	}
+
 	void initialize_pipe_compiler(int num_worker_threads)
 	{
 		if (num_worker_threads == 0)
@@ -266,4 +279,120 @@ namespace vk
 
 		return g_pipe_compilers.get()->begin() + (thread_index % g_num_pipe_compilers);
 	}
+
+	void initialize_pipeline_cache(const std::string& cache_dir)
+	{
+		ensure(g_render_device);
+		ensure(!g_pipeline_cache);
+
+		const auto& props = g_render_device->gpu().get_properties();
+		std::vector<u8> initial_data;
+
+		if (!cache_dir.empty())
+		{
+			// The driver blob is only valid for the exact device and driver build
+			g_pipeline_cache_path = fmt::format("%s/%04x-%04x-", cache_dir, props.vendorID, props.deviceID);
+
+			for (u8 byte : props.pipelineCacheUUID)
+			{
+				fmt::append(g_pipeline_cache_path, "%02x", byte);
+			}
+
+			g_pipeline_cache_path += ".bin";
+
+			if (fs::file f{g_pipeline_cache_path})
+			{
+				initial_data = f.to_vector<u8>();
+			}
+		}
+
+		// Validate the header ourselves, some drivers do not handle foreign data gracefully
+		constexpr usz header_size = 16 + VK_UUID_SIZE;
+
+		if (!initial_data.empty())
+		{
+			const u32* header = reinterpret_cast<const u32*>(initial_data.data());
+
+			if (initial_data.size() < header_size ||
+				header[0] < header_size ||
+				header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+				header[2] != props.vendorID ||
+				header[3] != props.deviceID ||
+				std::memcmp(initial_data.data() + 16, props.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+			{
+				rsx_log.warning("Discarding incompatible pipeline cache '%s'", g_pipeline_cache_path);
+				initial_data.clear();
+			}
+		}
+
+		VkPipelineCacheCreateInfo info = {};
+		info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		info.initialDataSize = initial_data.size();
+		info.pInitialData = initial_data.data();
+
+		if (vkCreatePipelineCache(*g_render_device, &info, nullptr, &g_pipeline_cache) != VK_SUCCESS && !initial_data.empty())
+		{
+			rsx_log.error("Failed to load pipeline cache '%s'", g_pipeline_cache_path);
+
+			info.initialDataSize = 0;
+			info.pInitialData = nullptr;
+			CHECK_RESULT(vkCreatePipelineCache(*g_render_device, &info, nullptr, &g_pipeline_cache));
+		}
+
+		if (!initial_data.empty())
+		{
+			rsx_log.notice("Loaded pipeline cache '%s' (%u bytes)", g_pipeline_cache_path, initial_data.size());
+		}
+	}
+
+	void destroy_pipeline_cache()
+	{
+		if (!g_pipeline_cache)
+		{
+			return;
+		}
+
+		usz size = 0;
+		std::vector<u8> data;
+
+		// Write back everything the compiler threads have added
+		if (!g_pipeline_cache_path.empty() && vkGetPipelineCacheData(*g_render_device, g_pipeline_cache, &size, nullptr) == VK_SUCCESS && size)
+		{
+			data.resize(size);
+
+			if (vkGetPipelineCacheData(*g_render_device, g_pipeline_cache, &size, data.data()) == VK_SUCCESS)
+			{
+				data.resize(size);
+			}
+			else
+			{
+				data.clear();
+			}
+		}
+
+		if (!data.empty())
+		{
+			fs::create_path(fs::get_parent_dir(g_pipeline_cache_path));
+
+			fs::pending_file file(g_pipeline_cache_path);
+
+			if (file.file && file.file.write(data.data(), data.size()) == data.size() && file.commit())
+			{
+				rsx_log.notice("Saved pipeline cache '%s' (%u bytes)", g_pipeline_cache_path, data.size());
+			}
+			else
+			{
+				rsx_log.error("Failed to save pipeline cache '%s' (error=%s)", g_pipeline_cache_path, fs::g_tls_error);
+			}
+		}
+
+		vkDestroyPipelineCache(*g_render_device, g_pipeline_cache, nullptr);
+		g_pipeline_cache = VK_NULL_HANDLE;
+		g_pipeline_cache_path.clear();
+	}
+
+	VkPipelineCache get_pipeline_cache()
+	{
+		return g_pipeline_cache;
+	}
 }
@@ -89,6 +89,9 @@ namespace vk
 			const std::vector<glsl::program_input>& vs_inputs = {},
 			const std::vector<glsl::program_input>& fs_inputs = {});
 
+		// Run an arbitrary task on a compiler thread
+		void post(std::function<void()> task);
+
 		void operator()();
 
 	private:
@@ -111,6 +114,7 @@ namespace vk
 		{
 			bool is_graphics_job;
 			callback_t callback_func;
+			std::function<void()> task_func;
 
 			vk::pipeline_props graphics_data;
 			compute_pipeline_props compute_data;
@@ -155,6 +159,16 @@ namespace vk
 
 				inputs = cs_in;
 			}
+
+			pipe_compiler_job(std::function<void()> task)
+			{
+				task_func = std::move(task);
+				is_graphics_job = false;
+				flags = COMPILE_DEFERRED;
+
+				graphics_modules[0] = VK_NULL_HANDLE;
+				graphics_modules[1] = VK_NULL_HANDLE;
+			}
 		};
 
 		const vk::render_device* m_device = nullptr;
@@ -182,6 +196,11 @@ namespace vk
 	void initialize_pipe_compiler(int num_worker_threads = -1);
 	void destroy_pipe_compiler();
 	pipe_compiler* get_pipe_compiler();
+
+	// Driver-side pipeline cache, persisted per title and per device/driver
+	void initialize_pipeline_cache(const std::string& cache_dir);
+	void destroy_pipeline_cache();
+	VkPipelineCache get_pipeline_cache();
 }
 
 namespace rpcs3
@@ -14,6 +14,15 @@ namespace vk
 		using pipeline_storage_type = std::unique_ptr<vk::glsl::program>;
 		using pipeline_properties = vk::pipeline_props;
 
+		// Decompile and SPIR-V generation of new programs run on the pipe compiler threads
+		static constexpr bool async_program_recompile = true;
+
+		static
+			void post_program_recompile(std::function<void()> task)
+		{
+			vk::get_pipe_compiler()->post(std::move(task));
+		}
+
 		static
 			void recompile_fragment_program(const RSXFragmentProgram& RSXFP, fragment_program_type& fragmentProgramData, usz ID)
 		{
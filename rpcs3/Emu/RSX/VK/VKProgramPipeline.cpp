@@ -9,6 +9,7 @@
 namespace vk
 {
 	extern const vk::render_device* get_current_renderer();
+	extern VkPipelineCache get_pipeline_cache();
 
 	namespace glsl
 	{
@@ -261,13 +262,13 @@ namespace vk
 			{
 				VkGraphicsPipelineCreateInfo create_info = *p_graphics_info;
 				create_info.layout = m_pipeline_layout;
-				CHECK_RESULT(vkCreateGraphicsPipelines(m_device, nullptr, 1, &create_info, nullptr, &m_pipeline));
+				CHECK_RESULT(vkCreateGraphicsPipelines(m_device, vk::get_pipeline_cache(), 1, &create_info, nullptr, &m_pipeline));
 			}
 			else
 			{
 				VkComputePipelineCreateInfo create_info = *p_compute_info;
 				create_info.layout = m_pipeline_layout;
-				CHECK_RESULT(vkCreateComputePipelines(m_device, nullptr, 1, &create_info, nullptr, &m_pipeline));
+				CHECK_RESULT(vkCreateComputePipelines(m_device, vk::get_pipeline_cache(), 1, &create_info, nullptr, &m_pipeline));
 			}
 
 			m_linked = true;
@@ -242,6 +242,7 @@ vk::vertex_upload_info VKGSRender::upload_vertex_data()
 		bool in_cache = false;
 		bool to_store = false;
 		u32  storage_address = -1;
+		rsx::simple_array<std::pair<u32, u32>> layout_ranges;
 
 		m_frame_stats.vertex_cache_request_count++;
 
@@ -263,6 +264,22 @@ vk::vertex_upload_info VKGSRender::upload_vertex_data()
 				to_store = true;
 			}
 		}
+		else if (m_vertex_layout.interleaved_blocks.size() > 1 &&
+			rsx::method_registers.current_draw_clause.command != rsx::draw_command::inlined_array)
+		{
+			// Separate streams, match on the combined source ranges instead
+			m_vertex_layout.calculate_interleaved_ranges(vertex_base, vertex_count, layout_ranges);
+
+			if (auto cached = m_vertex_cache->find_vertex_layout(layout_ranges, required.first))
+			{
+				in_cache = true;
+				persistent_range_base = cached->offset_in_heap;
+			}
+			else
+			{
+				to_store = true;
+			}
+		}
 
 		if (!in_cache)
 		{
@@ -271,7 +288,11 @@ vk::vertex_upload_info VKGSRender::upload_vertex_data()
 			persistent_offset = static_cast<u32>(m_attrib_ring_info.alloc<256>(required.first));
 			persistent_range_base = static_cast<u32>(persistent_offset);
 
-			if (to_store)
+			if (to_store && !layout_ranges.empty())
+			{
+				m_vertex_cache->store_layout(layout_ranges, required.first, static_cast<u32>(persistent_offset));
+			}
+			else if (to_store)
 			{
 				//store ref in vertex cache
 				m_vertex_cache->store_range(storage_address, required.first, static_cast<u32>(persistent_offset));
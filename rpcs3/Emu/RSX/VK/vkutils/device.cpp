@@ -440,6 +440,11 @@ namespace vk
 		return props.limits;
 	}
 
+	const VkPhysicalDeviceProperties& physical_device::get_properties() const
+	{
+		return props;
+	}
+
 	physical_device::operator VkPhysicalDevice() const
 	{
 		return dev;
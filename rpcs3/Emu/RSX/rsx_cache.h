@@ -4,6 +4,7 @@
 #include "Utilities/lockless.h"
 #include "Utilities/Thread.h"
 #include "Common/bitfield.hpp"
+#include "Common/simple_array.hpp"
 #include "Common/unordered_map.hpp"
 #include "Emu/System.h"
 #include "Emu/cache_utils.hpp"
@@ -12,6 +13,9 @@
 #include "Overlays/Shaders/shader_loading_dialog.h"
 
 #include <chrono>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "util/sysinfo.hpp"
 #include "util/fnv_hash.hpp"
@@ -66,11 +70,45 @@ namespace rsx
 			pipeline_storage_type pipeline_properties;
 		};
 
+		// Packed archive: a header followed by records, which are appended as new pipelines are seen
+		struct archive_header
+		{
+			u64 magic;
+			u32 version;
+			u32 pipeline_data_size;
+		};
+
+		struct archive_record
+		{
+			u32 type;
+			u32 size;
+			u64 key;
+		};
+
+		enum : u32
+		{
+			record_pipeline,
+			record_vertex_program,
+			record_fragment_program,
+			record_type_count
+		};
+
+		static constexpr u64 archive_magic = "RSXPIPES"_u64;
+		static constexpr u32 archive_version = 1;
+
 		std::string version_prefix;
 		std::string root_path;
 		std::string pipeline_class_name;
 		lf_fifo<std::unique_ptr<u8[]>, 100> fragment_program_data;
 
+		shared_mutex m_archive_mutex;
+		fs::file m_archive;
+		std::unordered_set<u64> m_archived_keys[record_type_count];
+
+		// Contents of the archive, only kept while loading
+		std::vector<u8> m_archive_data;
+		std::unordered_map<u64, std::span<const u8>> m_archived_ucode[record_type_count];
+
 		backend_storage& m_storage;
 
 		static std::string get_message(u32 index, u32 processed, u32 entry_count)
@@ -78,7 +116,7 @@ namespace rsx
 			return fmt::format("%s pipeline object %u of %u", index == 0 ? "Loading" : "Compiling", processed, entry_count);
 		}
 
-		void load_shaders(uint nb_workers, unpacked_type& unpacked, std::string& directory_path, std::vector<fs::dir_entry>& entries, u32 entry_count,
+		void load_shaders(uint nb_workers, unpacked_type& unpacked, const std::vector<pipeline_data>& packed_entries, std::string& directory_path, std::vector<fs::dir_entry>& entries, u32 entry_count,
 		    shader_loading_dialog* dlg)
 		{
 			atomic_t<u32> processed(0);
@@ -89,7 +127,25 @@ namespace rsx
 				// Processed is incremented before work starts in order to avoid two workers working on the same shader
 				while (((pos = processed++) < stop_at) && !Emu.IsStopped())
 				{
-					fs::dir_entry tmp = entries[pos];
+					if (pos < packed_entries.size())
+					{
+						pipeline_data pdata = packed_entries[pos];
+
+						auto entry = unpack(pdata);
+
+						if (std::get<1>(entry).data.empty() || !std::get<2>(entry).ucode_length)
+						{
+							continue;
+						}
+
+						m_storage.preload_programs(nullptr, std::get<1>(entry), std::get<2>(entry));
+
+						unpacked[unpacked.push_begin()] = std::move(entry);
+						continue;
+					}
+
+					// Legacy storage (one file per pipeline), moved into the archive
+					fs::dir_entry tmp = entries[pos - packed_entries.size()];
 
 					const auto filename = directory_path + "/" + tmp.name;
 					fs::file f(filename);
@@ -119,6 +175,12 @@ namespace rsx
 
 					m_storage.preload_programs(nullptr, std::get<1>(entry), std::get<2>(entry));
 
+					if (append_pipeline(pdata, std::get<1>(entry), std::get<2>(entry)))
+					{
+						f.close();
+						fs::remove_file(filename);
+					}
+
 					unpacked[unpacked.push_begin()] = std::move(entry);
 				}
 				// Do not account for an extra shader that was never processed
@@ -128,6 +190,165 @@ namespace rsx
 			await_workers(nb_workers, 0, shader_load_worker, processed, entry_count, dlg);
 		}
 
+		static u64 get_pipeline_key(const pipeline_data& data)
+		{
+			const u32 state_params[] =
+			{
+				data.vp_ctrl0,
+				data.vp_ctrl1,
+				data.fp_ctrl,
+				data.vp_texture_dimensions,
+				data.fp_texture_dimensions,
+				data.fp_texcoord_control,
+				data.fp_height,
+				data.fp_pixel_layout,
+				data.fp_lighting_flags,
+				data.fp_shadow_textures,
+				data.fp_redirected_textures,
+				data.vp_multisampled_textures,
+				data.fp_multisampled_textures,
+				data.fp_mrt_count,
+			};
+
+			const u64 key_params[] =
+			{
+				data.vertex_program_hash,
+				data.fragment_program_hash,
+				data.pipeline_storage_hash,
+				rpcs3::hash_array(state_params),
+			};
+
+			return rpcs3::hash_array(key_params);
+		}
+
+		// Open the archive for appending and read all of its records
+		std::vector<pipeline_data> open_archive(const std::string& archive_path)
+		{
+			std::vector<pipeline_data> result;
+
+			std::lock_guard lock(m_archive_mutex);
+
+			if (m_archive)
+			{
+				return result;
+			}
+
+			fs::create_path(fs::get_parent_dir(archive_path));
+
+			if (!m_archive.open(archive_path, fs::read + fs::write + fs::create))
+			{
+				rsx_log.error("shaders_cache: Failed to open '%s' (error=%s)", archive_path, fs::g_tls_error);
+				return result;
+			}
+
+			// Read everything at once, this is much faster than accessing many small files
+			m_archive_data = m_archive.to_vector<u8>();
+
+			archive_header header{};
+
+			if (m_archive_data.size() >= sizeof(header))
+			{
+				std::memcpy(&header, m_archive_data.data(), sizeof(header));
+			}
+
+			if (header.magic != archive_magic || header.version != archive_version || header.pipeline_data_size != sizeof(pipeline_data))
+			{
+				if (!m_archive_data.empty())
+				{
+					rsx_log.error("Removing pipeline cache archive %s since it's not binary compatible with the current shader cache", archive_path);
+				}
+
+				header = {archive_magic, archive_version, sizeof(pipeline_data)};
+
+				m_archive.trunc(0);
+				m_archive.seek(0);
+				m_archive.write(header);
+				m_archive_data.clear();
+				return result;
+			}
+
+			usz pos = sizeof(header);
+
+			while (m_archive_data.size() - pos >= sizeof(archive_record))
+			{
+				archive_record record{};
+				std::memcpy(&record, m_archive_data.data() + pos, sizeof(record));
+
+				const usz data_pos = pos + sizeof(record);
+
+				if (record.type >= record_type_count || record.size > m_archive_data.size() - data_pos || (record.type == record_pipeline && record.size != sizeof(pipeline_data)))
+				{
+					// Incomplete or damaged record
+					break;
+				}
+
+				if (m_archived_keys[record.type].emplace(record.key).second)
+				{
+					if (record.type == record_pipeline)
+					{
+						std::memcpy(&result.emplace_back(), m_archive_data.data() + data_pos, sizeof(pipeline_data));
+					}
+					else
+					{
+						m_archived_ucode[record.type].emplace(record.key, std::span<const u8>(m_archive_data.data() + data_pos, record.size));
+					}
+				}
+
+				pos = data_pos + record.size;
+			}
+
+			if (pos != m_archive_data.size())
+			{
+				// Most likely the process was terminated while appending
+				rsx_log.warning("shaders_cache: Discarding %u bytes at the end of '%s'", m_archive_data.size() - pos, archive_path);
+				m_archive.trunc(pos);
+			}
+
+			m_archive.seek(pos);
+			return result;
+		}
+
+		void append_record(u32 type, u64 key, const void* data, u32 size)
+		{
+			const archive_record record{type, size, key};
+
+			m_archive.write(record);
+			m_archive.write(data, size);
+		}
+
+		// Returns true if the pipeline is present in the archive
+		bool append_pipeline(const pipeline_data& data, const RSXVertexProgram& vp, const RSXFragmentProgram& fp)
+		{
+			const u64 key = get_pipeline_key(data);
+
+			std::lock_guard lock(m_archive_mutex);
+
+			if (!m_archive)
+			{
+				return false;
+			}
+
+			if (m_archived_keys[record_pipeline].contains(key))
+			{
+				return true;
+			}
+
+			// Programs shared by many pipelines are only stored once, and always before the pipelines using them
+			if (m_archived_keys[record_vertex_program].emplace(data.vertex_program_hash).second)
+			{
+				append_record(record_vertex_program, data.vertex_program_hash, vp.data.data(), ::size32(vp.data) * sizeof(u32));
+			}
+
+			if (m_archived_keys[record_fragment_program].emplace(data.fragment_program_hash).second)
+			{
+				append_record(record_fragment_program, data.fragment_program_hash, fp.get_data(), fp.ucode_length);
+			}
+
+			m_archived_keys[record_pipeline].emplace(key);
+			append_record(record_pipeline, key, &data, sizeof(data));
+			return true;
+		}
+
 		template <typename... Args>
 		void compile_shaders(uint nb_workers, unpacked_type& unpacked, u32 entry_count, shader_loading_dialog* dlg, Args&&... args)
 		{
@@ -221,6 +442,12 @@ namespace rsx
 			}
 		}
 
+		// Directory for backend data persisted alongside the pipelines, empty if the disk cache is disabled
+		std::string get_backend_cache_path(std::string_view name) const
+		{
+			return root_path.empty() ? std::string{} : fmt::format("%s/pipelines/%s/%s", root_path, pipeline_class_name, name);
+		}
+
 		template <typename... Args>
 		void load(shader_loading_dialog* dlg, Args&& ...args)
 		{
@@ -231,31 +458,28 @@ namespace rsx
 
 			std::string directory_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix;
 
-			fs::dir root = fs::dir(directory_path);
-
-			if (!root)
-			{
-				fs::create_path(directory_path);
-				fs::create_path(root_path + "/raw");
-				return;
-			}
+			const std::vector<pipeline_data> packed_entries = open_archive(directory_path + ".pack");
 
 			std::vector<fs::dir_entry> entries;
 
-			for (auto&& tmp : root)
+			if (fs::dir root{directory_path})
 			{
-				if (tmp.is_directory)
-					continue;
+				for (auto&& tmp : root)
+				{
+					if (tmp.is_directory)
+						continue;
 
-				entries.push_back(tmp);
+					entries.push_back(tmp);
+				}
 			}
 
-			u32 entry_count = ::size32(entries);
+			u32 entry_count = ::size32(packed_entries) + ::size32(entries);
 
 			if (!entry_count)
+			{
+				release_archive_data();
 				return;
-
-			root.rewind();
+			}
 
 			// Progress dialog
 			std::unique_ptr<shader_loading_dialog> fallback_dlg;
@@ -275,7 +499,8 @@ namespace rsx
 			unpacked_type unpacked;
 			uint nb_workers = g_cfg.video.renderer == video_renderer::vulkan ? utils::get_thread_count() : 1;
 
-			load_shaders(nb_workers, unpacked, directory_path, entries, entry_count, dlg);
+			load_shaders(nb_workers, unpacked, packed_entries, directory_path, entries, entry_count, dlg);
+			release_archive_data();
 
 			// Account for any invalid entries
 			entry_count = unpacked.size();
@@ -299,51 +524,33 @@ namespace rsx
 				return;
 			}
 
-			pipeline_data data = pack(pipeline, vp, fp);
-
-			std::string fp_name = root_path + "/raw/" + fmt::format("%llX.fp", data.fragment_program_hash);
-			std::string vp_name = root_path + "/raw/" + fmt::format("%llX.vp", data.vertex_program_hash);
+			append_pipeline(pack(pipeline, vp, fp), vp, fp);
+		}
 
-			// Writeback to cache either if file does not exist or it is invalid (unexpected size)
-			// Note: fs::write_file is not atomic, if the process is terminated in the middle an empty file is created
-			if (fs::stat_t s{}; !fs::get_stat(fp_name, s) || s.size != fp.ucode_length)
-			{
-				fs::write_file(fp_name, fs::rewrite, fp.get_data(), fp.ucode_length);
-			}
+		void release_archive_data()
+		{
+			std::lock_guard lock(m_archive_mutex);
 
-			if (fs::stat_t s{}; !fs::get_stat(vp_name, s) || s.size != vp.data.size() * sizeof(u32))
+			for (auto& ucode : m_archived_ucode)
 			{
-				fs::write_file(vp_name, fs::rewrite, vp.data);
+				ucode.clear();
 			}
 
-			const u32 state_params[] =
-			{
-				data.vp_ctrl0,
-				data.vp_ctrl1,
-				data.fp_ctrl,
-				data.vp_texture_dimensions,
-				data.fp_texture_dimensions,
-				data.fp_texcoord_control,
-				data.fp_height,
-				data.fp_pixel_layout,
-				data.fp_lighting_flags,
-				data.fp_shadow_textures,
-				data.fp_redirected_textures,
-				data.vp_multisampled_textures,
-				data.fp_multisampled_textures,
-				data.fp_mrt_count,
-			};
-			const usz state_hash = rpcs3::hash_array(state_params);
-
-			const std::string pipeline_file_name = fmt::format("%llX+%llX+%llX+%llX.bin", data.vertex_program_hash, data.fragment_program_hash, data.pipeline_storage_hash, state_hash);
-			const std::string pipeline_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix + "/" + pipeline_file_name;
-			fs::write_file(pipeline_path, fs::rewrite, &data, sizeof(data));
+			m_archive_data = {};
 		}
 
 		RSXVertexProgram load_vp_raw(u64 program_hash) const
 		{
 			RSXVertexProgram vp = {};
 
+			if (const auto found = m_archived_ucode[record_vertex_program].find(program_hash); found != m_archived_ucode[record_vertex_program].end())
+			{
+				const auto& ucode = found->second;
+				vp.data.resize(ucode.size() / sizeof(u32));
+				std::memcpy(vp.data.data(), ucode.data(), vp.data.size() * sizeof(u32));
+				return vp;
+			}
+
 			fs::file f(fmt::format("%s/raw/%llX.vp", root_path, program_hash));
 			if (f) f.read(vp.data, f.size() / sizeof(u32));
 
@@ -352,11 +559,21 @@ namespace rsx
 
 		RSXFragmentProgram load_fp_raw(u64 program_hash)
 		{
-			fs::file f(fmt::format("%s/raw/%llX.fp", root_path, program_hash));
-
 			RSXFragmentProgram fp = {};
 
-			const u32 size = fp.ucode_length = f ? ::size32(f) : 0;
+			std::span<const u8> ucode;
+			fs::file f;
+
+			if (const auto found = m_archived_ucode[record_fragment_program].find(program_hash); found != m_archived_ucode[record_fragment_program].end())
+			{
+				ucode = found->second;
+			}
+			else
+			{
+				f.open(fmt::format("%s/raw/%llX.fp", root_path, program_hash));
+			}
+
+			const u32 size = fp.ucode_length = f ? ::size32(f) : ::size32(ucode);
 
 			if (!size)
 			{
@@ -365,7 +582,16 @@ namespace rsx
 
 			auto buf = std::make_unique<u8[]>(size);
 			fp.data = buf.get();
-			f.read(buf.get(), size);
+
+			if (f)
+			{
+				f.read(buf.get(), size);
+			}
+			else
+			{
+				std::memcpy(buf.get(), ucode.data(), size);
+			}
+
 			fragment_program_data[fragment_program_data.push_begin()] = std::move(buf);
 			return fp;
 		}
@@ -470,6 +696,8 @@ namespace rsx
 			virtual ~default_vertex_cache() = default;
 			virtual const storage_type* find_vertex_range(u32 /*local_addr*/, u32 /*data_length*/) { return nullptr; }
 			virtual void store_range(u32 /*local_addr*/, u32 /*data_length*/, u32 /*offset_in_heap*/) {}
+			virtual const storage_type* find_vertex_layout(const rsx::simple_array<std::pair<u32, u32>>& /*ranges*/, u32 /*data_length*/) { return nullptr; }
+			virtual void store_layout(const rsx::simple_array<std::pair<u32, u32>>& /*ranges*/, u32 /*data_length*/, u32 /*offset_in_heap*/) {}
 			virtual void purge() {}
 		};
 
@@ -491,11 +719,36 @@ namespace rsx
 		private:
 			rsx::unordered_map<uptr, storage_type> vertex_ranges;
 
+			struct uploaded_layout
+			{
+				storage_type range;
+				rsx::simple_array<std::pair<u32, u32>> blocks;
+			};
+
+			// Uploads made of several separate streams, keyed by the hash of their source ranges
+			rsx::unordered_map<u64, uploaded_layout> layout_ranges;
+
 			FORCE_INLINE u64 hash(u32 local_addr, u32 data_length) const
 			{
 				return u64(local_addr) | (u64(data_length) << 32);
 			}
 
+			u64 hash(const rsx::simple_array<std::pair<u32, u32>>& ranges) const
+			{
+				usz result = rpcs3::fnv_seed;
+				for (const auto& [address, length] : ranges)
+				{
+					result = rpcs3::hash64(result, hash(address, length));
+				}
+
+				return result;
+			}
+
+			static bool equal(const rsx::simple_array<std::pair<u32, u32>>& a, const rsx::simple_array<std::pair<u32, u32>>& b)
+			{
+				return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+			}
+
 		public:
 
 			const storage_type* find_vertex_range(u32 local_addr, u32 data_length) override
@@ -521,9 +774,32 @@ namespace rsx
 				vertex_ranges[key] = v;
 			}
 
+			const storage_type* find_vertex_layout(const rsx::simple_array<std::pair<u32, u32>>& ranges, u32 data_length) override
+			{
+				const auto found = layout_ranges.find(hash(ranges));
+				if (found == layout_ranges.end() || found->second.range.data_length != data_length || !equal(found->second.blocks, ranges))
+				{
+					return nullptr;
+				}
+
+				return std::addressof(found->second.range);
+			}
+
+			void store_layout(const rsx::simple_array<std::pair<u32, u32>>& ranges, u32 data_length, u32 offset_in_heap) override
+			{
+				uploaded_layout v = {};
+				v.range.data_length = data_length;
+				v.range.local_address = ranges[0].first;
+				v.range.offset_in_heap = offset_in_heap;
+				v.blocks = ranges;
+
+				layout_ranges[hash(ranges)] = std::move(v);
+			}
+
 			void purge() override
 			{
 				vertex_ranges.clear();
+				layout_ranges.clear();
 			}
 		};
 	}
@@ -2,6 +2,7 @@
 #include "VFS.h"
 #include "Utilities/bin_patch.h"
 #include "Emu/Memory/vm.h"
+#include "Emu/Memory/vm_reservation.h"
 #include "Emu/System.h"
 #include "Emu/system_progress.hpp"
 #include "Emu/system_utils.hpp"
@@ -630,6 +631,7 @@ void Emulator::Init()
 	make_path_verbose(fs::get_cache_dir() + "shaderlog/", false);
 	make_path_verbose(fs::get_cache_dir() + "spu_progs/", false);
 	make_path_verbose(fs::get_cache_dir() + "ppu_progs/", false);
+	make_path_verbose(fs::get_cache_dir() + "spirv/", false);
 	make_path_verbose(fs::get_parent_dir(get_savestate_file("NO_ID", "/NO_FILE", -1, -1)), false);
 	make_path_verbose(fs::get_config_dir() + "captures/", false);
 	make_path_verbose(fs::get_config_dir() + "sounds/", false);
@@ -1048,6 +1050,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 		else
 		{
 			m_ar = make_savestate_reader(m_path);
+			set_savestate_page_pool(m_path);
 
 			m_boot_source_type = CELL_GAME_GAMETYPE_SYS;
 		}
@@ -1536,6 +1539,11 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 		// Set RTM usage
 		g_use_rtm = utils::has_rtm() && (((utils::has_mpx() && !utils::has_tsx_force_abort()) && g_cfg.core.enable_TSX == tsx_usage::enabled) || g_cfg.core.enable_TSX == tsx_usage::forced);
 
+		// Set reservation notifier mode
+		vm::g_resrv_exact_waiters = g_cfg.core.spu_exact_reservation_waiters.get();
+		vm::g_resrv_waiter_wakeups = 0;
+		vm::g_resrv_waiter_spurious = 0;
+
 		{
 			// Log some extra info in case of boot
 #if defined(HAVE_VULKAN)
@@ -2172,6 +2180,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 
 				vm::init();
 				vm::load(*m_ar);
+				set_savestate_page_pool({});
 
 				if (!hdd1.empty())
 				{
@@ -2219,7 +2228,8 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 
 		if (m_ar)
 		{
-			vm::load(*m_ar);
+			vm::load(*m_ar, g_cfg.savestate.lazy_memory_load ? make_savestate_reader(m_path) : nullptr);
+			set_savestate_page_pool({});
 		}
 
 		if (!hdd1.empty())
@@ -3386,10 +3396,16 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 			*verbose_message = stx::make_single<std::string>(text);
 		};
 
+		// Serialize to memory and let a background thread compress and write it (not in suspend mode, which deletes the file after loading)
+		const bool write_in_background = savestate && g_cfg.savestate.background_write && !g_cfg.savestate.suspend_emu;
+
 		while (savestate)
 		{
 			set_progress_message("Creating File");
 
+			// The previous savestate must be on disk in order to select a new file name
+			wait_for_background_savestate();
+
 			path = get_savestate_file(m_title_id, m_path, 0, umax);
 
 			// The function is meant for reading files, so if there is no ZST file it would not return compressed file path
@@ -3405,7 +3421,7 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 				break;
 			}
 
-			if (!file.open(path))
+			if (!write_in_background && !file.open(path))
 			{
 				sys_log.error("Failed to create savestate temporary file! (path='%s', %s)", file.get_temp_path(), fs::g_tls_error);
 				savestate = false;
@@ -3413,7 +3429,12 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 			}
 
 			auto serial_ptr = stx::make_single<utils::serial>();
-			serial_ptr->m_file_handler = make_compressed_zstd_serialization_file_handler(file.file);
+
+			if (!write_in_background)
+			{
+				serial_ptr->m_file_handler = make_compressed_zstd_serialization_file_handler(file.file);
+			}
+
 			*to_ar = std::move(serial_ptr);
 
 			signal_system_cache_can_stay();
@@ -3437,6 +3458,13 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 				read_used_savestate_versions(); // Reset version data
 				USING_SERIALIZATION_VERSION(global_version);
 
+				if (g_cfg.savestate.delta_mode)
+				{
+					USING_SERIALIZATION_VERSION(vm);
+				}
+
+				set_savestate_page_pool(g_cfg.savestate.delta_mode ? path : std::string{});
+
 				// Avoid duplicating TAR object memory because it can be very large
 				auto save_tar = [&](const std::string& path)
 				{
@@ -3558,6 +3586,7 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 
 				set_progress_message("Saving VMemory");
 				vm::save(ar);
+				set_savestate_page_pool({});
 
 				set_progress_message("Saving FXO");
 				g_fxo->save(ar);
@@ -3578,7 +3607,11 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 
 				// Final file write, the file is ready to be committed
 				ar.seek_end();
-				ar.m_file_handler->finalize(ar);
+
+				if (ar.m_file_handler)
+				{
+					ar.m_file_handler->finalize(ar);
+				}
 			});
 
 			// Join it
@@ -3598,15 +3631,24 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 
 			set_progress_message("Commiting File");
 
+			std::vector<u8> state_data;
+
 			{
 				auto& ar = *to_ar->load();
 				auto reset = init_mtx->reset();
+
+				if (write_in_background)
+				{
+					state_data = std::move(ar.data);
+					file_stat.size = state_data.size();
+				}
+
 				ar = {};
 				ar.set_reading_state(); // Guard against using it
 				reset.set_init();
 			}
 
-			if (!file.commit() || !fs::get_stat(path, file_stat))
+			if (!write_in_background && (!file.commit() || !fs::get_stat(path, file_stat)))
 			{
 				sys_log.error("Failed to write savestate to file! (path='%s', %s)", path, fs::g_tls_error);
 				savestate = false;
@@ -3643,7 +3685,27 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 				const u64 max_files = g_cfg.savestate.max_files;
 				const u64 max_files_size_mb = g_cfg.savestate.max_files_size;
 
-				clean_savestates(m_title_id, m_path, max_files, max_files_size_mb << 20);
+				if (write_in_background)
+				{
+					write_savestate_in_background(path, std::move(state_data), [title_id = m_title_id, boot_path = m_path, max_files, max_files_size_mb](bool success)
+					{
+						if (!success)
+						{
+							// The emulation may already have been rebooted from the state in memory, report it regardless
+							Emu.CallFromMainThread([]()
+							{
+								rsx::overlays::queue_message(localized_string_id::SAVESTATE_FAILED_TO_WRITE);
+							}, nullptr, false);
+							return;
+						}
+
+						clean_savestates(title_id, boot_path, max_files, max_files_size_mb << 20);
+					});
+				}
+				else
+				{
+					clean_savestates(m_title_id, m_path, max_files, max_files_size_mb << 20);
+				}
 			}
 		}
 
@@ -3806,6 +3868,7 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 			});
 
 			sys_log.notice("Atomic wait hashtable stats: [in_use=%u, used=%u, max_collision_weight=%u, total_collisions=%u]", aw_refs, aw_used, aw_colm, aw_colc);
+			sys_log.notice("Reservation notifier stats: [exact=%d, wakeups=%u, spurious=%u]", vm::g_resrv_exact_waiters, vm::g_resrv_waiter_wakeups.load(), vm::g_resrv_waiter_spurious.load());
 
 			m_stop_ctr++;
 			m_stop_ctr.notify_all();
@@ -3913,6 +3976,9 @@ bool Emulator::Quit(bool force_quit)
 
 void Emulator::CleanUp()
 {
+	// Do not lose a savestate which is still being written
+	wait_for_background_savestate();
+
 	// Deinitialize object manager to prevent any hanging objects at program exit
 	g_fxo->clear();
 }
@@ -318,4 +318,5 @@ enum class localized_string_id
 	SAVESTATE_FAILED_DUE_TO_SAVEDATA,
 	SAVESTATE_FAILED_DUE_TO_SPU,
 	SAVESTATE_FAILED_DUE_TO_MISSING_SPU_SETTING,
+	SAVESTATE_FAILED_TO_WRITE,
 };
@@ -155,3 +155,34 @@ void perf_stat_base::report() noexcept
 
 	perf_log.notice("Performance report end.");
 }
+
+void perf_stat_base::snapshot(std::vector<std::pair<std::string, std::array<u64, 66>>>& out) noexcept
+{
+	std::map<std::string, std::array<u64, 66>> result;
+
+	{
+		reader_lock lock(s_perf_mutex);
+
+		for (auto& [name, data] : s_perf_acc)
+		{
+			auto& dst = result[name];
+
+			for (u32 i = 0; i < 66; i++)
+			{
+				dst[i] += data.m_log[i].load();
+			}
+		}
+
+		for (auto& [name, ns] : s_perf_sources)
+		{
+			auto& dst = result[name];
+
+			for (u32 i = 0; i < 66; i++)
+			{
+				dst[i] += atomic_storage<u64>::load(ns[i]);
+			}
+		}
+	}
+
+	out.assign(std::make_move_iterator(result.begin()), std::make_move_iterator(result.end()));
+}
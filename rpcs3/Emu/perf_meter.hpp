@@ -6,6 +6,8 @@
 #include "system_config.h"
 #include <array>
 #include <cmath>
+#include <string>
+#include <vector>
 
 LOG_CHANNEL(perf_log, "PERF");
 
@@ -50,6 +52,9 @@ public:
 
 	// Collect all data, report it, and clean
 	static void report() noexcept;
+
+	// Copy current totals (accumulated and live thread data) without draining them
+	static void snapshot(std::vector<std::pair<std::string, std::array<u64, 66>>>& out) noexcept;
 };
 
 // Object that prints event length stats at the end
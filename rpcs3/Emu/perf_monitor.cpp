@@ -2,11 +2,71 @@
 #include "perf_monitor.hpp"
 
 #include "Emu/System.h"
+#include "Emu/system_config.h"
+#include "Emu/perf_meter.hpp"
 #include "Emu/Cell/timers.hpp"
 #include "util/cpu_stats.hpp"
+#include "Utilities/File.h"
 #include "Utilities/Thread.h"
 
-LOG_CHANNEL(perf_log, "PERF");
+void perf_monitor::export_telemetry(u64 time_us, double total_usage, const std::vector<double>& per_core_usage)
+{
+	constexpr u64 max_file_size = 16 * 1024 * 1024;
+
+	const std::string path = fs::get_log_dir() + "perf_telemetry.jsonl";
+
+	// Rotate: keep the previous file as .1
+	if (m_telemetry && m_telemetry.size() >= max_file_size)
+	{
+		m_telemetry.close();
+		fs::rename(path, path + ".1", true);
+	}
+
+	if (!m_telemetry && !m_telemetry.open(path, fs::rewrite))
+	{
+		perf_log.error("Failed to open %s (%s)", path, fs::g_tls_error);
+		return;
+	}
+
+	perf_stat_base::snapshot(m_stats);
+
+	// One JSON object per line, perf values are cumulative since the last report
+	std::string line;
+	fmt::append(line, "{\"time_us\":%u,\"cpu\":%.1f,\"cores\":[", time_us, total_usage);
+
+	for (usz i = 0; i < per_core_usage.size(); i++)
+	{
+		fmt::append(line, "%s%.1f", i > 0 ? "," : "", per_core_usage[i]);
+	}
+
+	line += "],\"perf\":{";
+
+	for (usz i = 0; i < m_stats.size(); i++)
+	{
+		const auto& [name, data] = m_stats[i];
+
+		// data[0]: event count, data[1..64]: histogram by bit length of ns, data[65]: total ns
+		fmt::append(line, "%s\"%s\":{\"events\":%u,\"total_ns\":%u,\"hist\":[", i > 0 ? "," : "", name.c_str(), data[0], data[65]);
+
+		usz last = 64;
+
+		while (last > 1 && !data[last])
+		{
+			last--;
+		}
+
+		for (usz j = 1; j <= last; j++)
+		{
+			fmt::append(line, "%s%u", j > 1 ? "," : "", data[j]);
+		}
+
+		line += "]}";
+	}
+
+	line += "}}\n";
+
+	m_telemetry.write(line);
+}
 
 void perf_monitor::operator()()
 {
@@ -37,6 +97,11 @@ void perf_monitor::operator()()
 
 		stats.get_per_core_usage(per_core_usage, total_usage);
 
+		if (g_cfg.core.perf_telemetry && g_cfg.core.perf_report)
+		{
+			export_telemetry(get_system_time(), total_usage, per_core_usage);
+		}
+
 		if (elapsed_us >= log_interval_us)
 		{
 			elapsed_us = 0;
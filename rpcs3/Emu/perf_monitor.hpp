@@ -1,6 +1,12 @@
 #pragma once
 
+#include "util/types.hpp"
+#include "Utilities/File.h"
+
+#include <array>
+#include <string>
 #include <string_view>
+#include <vector>
 using namespace std::literals;
 
 struct perf_monitor
@@ -9,4 +15,11 @@ struct perf_monitor
 	~perf_monitor();
 
 	static constexpr auto thread_name = "Performance Sensor"sv;
+
+private:
+	// Telemetry export (JSON lines in the log directory)
+	fs::file m_telemetry;
+	std::vector<std::pair<std::string, std::array<u64, 66>>> m_stats;
+
+	void export_telemetry(u64 time_us, double total_usage, const std::vector<double>& per_core_usage);
 };
@@ -5,13 +5,19 @@
 #include "util/simd.hpp"
 #include "Utilities/File.h"
 #include "Utilities/StrFmt.h"
+#include "Utilities/mutex.h"
+#include "Utilities/Thread.h"
+#include "Crypto/sha1.h"
 #include "system_config.h"
 #include "savestate_utils.hpp"
+#include "Emu/Cell/timers.hpp"
 
 #include "System.h"
 
 #include <set>
 #include <span>
+#include <thread>
+#include <zstd.h>
 
 LOG_CHANNEL(sys_log, "SYS");
 
@@ -23,7 +29,7 @@ struct serial_ver_t
 	std::set<u16> compatible_versions;
 };
 
-static std::array<serial_ver_t, 27> s_serial_versions;
+static std::array<serial_ver_t, 28> s_serial_versions;
 
 #define SERIALIZATION_VER(name, identifier, ...) \
 \
@@ -86,6 +92,9 @@ SERIALIZATION_VER(HLE, 25,                                      1)
 
 SERIALIZATION_VER(cellSysutil, 26,                              1, 2/*AVC2 Muting,Volume*/)
 
+// Memory chunks stored in the page pool (delta savestates)
+SERIALIZATION_VER(vm, 27,                                       1)
+
 template <>
 void fmt_class_string<std::remove_cvref_t<decltype(s_serial_versions)>>::format(std::string& out, u64 arg)
 {
@@ -160,10 +169,533 @@ std::vector<version_entry> get_savestate_versioning_data(fs::file&& file, std::s
 	return ver_data;
 }
 
+namespace
+{
+	// Record header of a chunk in the page pool file, followed by its compressed data
+	struct page_pool_record
+	{
+		savestate_page_pool::hash_t hash;
+		le_t<u32> size;
+		le_t<u32> data_size;
+	};
+
+	// Entry of the reference file, followed by the savestate file name and the hashes of its chunks
+	struct page_pool_ref_header
+	{
+		le_t<u32> name_size;
+		le_t<u32> count;
+	};
+
+	std::unique_ptr<savestate_page_pool> s_page_pool;
+
+	// Protects the pool files from garbage collection while a pool is in use
+	std::mutex s_page_pool_mutex;
+}
+
+savestate_page_pool::savestate_page_pool(std::string dir_path, std::string state_name)
+	: m_path(dir_path + "pages.dat")
+	, m_ref_path(dir_path + "pages.ref")
+	, m_state_name(std::move(state_name))
+{
+}
+
+savestate_page_pool::hash_t savestate_page_pool::hash(const u8* data, usz size)
+{
+	hash_t result{};
+	sha1(data, size, result.data());
+	return result;
+}
+
+bool savestate_page_pool::open(bool write)
+{
+	if (m_file && (m_writable || !write))
+	{
+		return true;
+	}
+
+	m_file.close();
+	m_entries.clear();
+	m_writable = write;
+
+	if (!m_file.open(m_path, write ? fs::read + fs::write + fs::create : fs::read))
+	{
+		sys_log.error("Failed to open savestate page pool '%s' (%s)", m_path, fs::g_tls_error);
+		return false;
+	}
+
+	// Build the index, a partially written record at the end (interrupted save) is discarded
+	const u64 file_size = m_file.size();
+	u64 pos = 0;
+
+	for (page_pool_record record{}; pos + sizeof(record) <= file_size && m_file.read(record);)
+	{
+		const u64 next = pos + sizeof(record) + record.size;
+
+		if (next > file_size || record.data_size > chunk_size)
+		{
+			break;
+		}
+
+		m_entries.emplace(record.hash, entry_t{pos + sizeof(record), record.size, record.data_size});
+		m_file.seek(next);
+		pos = next;
+	}
+
+	if (write && pos != file_size)
+	{
+		sys_log.warning("Savestate page pool '%s' has trailing data (pos=0x%x, size=0x%x)", m_path, pos, file_size);
+		m_file.trunc(pos);
+	}
+
+	m_file.seek(pos);
+	sys_log.notice("Opened savestate page pool '%s' (chunks=%d, size=0x%x)", m_path, m_entries.size(), pos);
+	return true;
+}
+
+void savestate_page_pool::store(const hash_t& hash, const u8* data, usz size)
+{
+	ensure(size <= chunk_size);
+
+	if (!open(true))
+	{
+		fmt::throw_exception("Savestate page pool is not available (path='%s')", m_path);
+	}
+
+	m_used.emplace(hash);
+
+	if (m_entries.contains(hash))
+	{
+		return;
+	}
+
+	m_buffer.resize(ZSTD_compressBound(chunk_size));
+
+	const usz comp_size = ZSTD_compress(m_buffer.data(), m_buffer.size(), data, size, 1);
+
+	if (ZSTD_isError(comp_size))
+	{
+		fmt::throw_exception("Failed to compress savestate chunk: %s", ZSTD_getErrorName(comp_size));
+	}
+
+	page_pool_record record{};
+	record.hash = hash;
+	record.size = ::narrow<u32>(comp_size);
+	record.data_size = ::narrow<u32>(size);
+
+	const u64 pos = m_file.seek(0, fs::seek_end);
+
+	if (m_file.write(&record, sizeof(record)) != sizeof(record) || m_file.write(m_buffer.data(), comp_size) != comp_size)
+	{
+		fmt::throw_exception("Failed to write savestate page pool '%s' (%s)", m_path, fs::g_tls_error);
+	}
+
+	m_entries.emplace(hash, entry_t{pos + sizeof(record), record.size, record.data_size});
+}
+
+bool savestate_page_pool::load(const hash_t& hash, u8* data, usz size)
+{
+	if (!open(false))
+	{
+		return false;
+	}
+
+	const auto found = m_entries.find(hash);
+
+	if (found == m_entries.end() || found->second.data_size != size)
+	{
+		return false;
+	}
+
+	m_buffer.resize(found->second.size);
+
+	if (m_file.read_at(found->second.offset, m_buffer.data(), m_buffer.size()) != m_buffer.size())
+	{
+		return false;
+	}
+
+	const usz res = ZSTD_decompress(data, size, m_buffer.data(), m_buffer.size());
+	return !ZSTD_isError(res) && res == size && savestate_page_pool::hash(data, size) == hash;
+}
+
+void savestate_page_pool::commit()
+{
+	if (!m_writable)
+	{
+		return;
+	}
+
+	// Written before the savestate is committed, references of savestates which do not exist are dropped later
+	fs::file ref_file(m_ref_path, fs::write + fs::create + fs::append);
+
+	page_pool_ref_header header{};
+	header.name_size = ::size32(m_state_name);
+	header.count = ::size32(m_used);
+
+	std::vector<u8> data(sizeof(header) + m_state_name.size());
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), m_state_name.data(), m_state_name.size());
+
+	for (const hash_t& hash : m_used)
+	{
+		data.insert(data.end(), hash.begin(), hash.end());
+	}
+
+	if (!ref_file || ref_file.write(data.data(), data.size()) != data.size())
+	{
+		fmt::throw_exception("Failed to write savestate page pool references '%s' (%s)", m_ref_path, fs::g_tls_error);
+	}
+
+	m_used.clear();
+}
+
+u64 savestate_page_pool::collect_garbage(const std::string& dir_path)
+{
+	std::lock_guard lock(s_page_pool_mutex);
+
+	const std::string pool_path = dir_path + "pages.dat";
+	const std::string ref_path = dir_path + "pages.ref";
+
+	fs::stat_t pool_stat{};
+	fs::stat_t ref_stat{};
+
+	if (!fs::get_stat(pool_path, pool_stat))
+	{
+		return 0;
+	}
+
+	fs::get_stat(ref_path, ref_stat);
+
+	if (s_page_pool)
+	{
+		// In use, try again after the next savestate
+		return pool_stat.size + ref_stat.size;
+	}
+
+	// Keep the references of savestates which still exist (loaded ones may have been hidden with the "used_" prefix)
+	const std::vector<u8> refs = fs::file(ref_path).to_vector<u8>();
+	std::vector<u8> live_refs;
+	std::set<hash_t> live;
+
+	for (usz pos = 0; pos + sizeof(page_pool_ref_header) <= refs.size();)
+	{
+		page_pool_ref_header header{};
+		std::memcpy(&header, refs.data() + pos, sizeof(header));
+
+		const usz entry_size = sizeof(header) + header.name_size + usz{header.count} * sizeof(hash_t);
+
+		if (refs.size() - pos < entry_size)
+		{
+			// Interrupted write
+			break;
+		}
+
+		const std::string name(reinterpret_cast<const char*>(refs.data() + pos + sizeof(header)), header.name_size);
+
+		if (fs::is_file(dir_path + name) || fs::is_file(dir_path + "used_" + name))
+		{
+			for (u32 i = 0; i < header.count; i++)
+			{
+				hash_t hash{};
+				std::memcpy(hash.data(), refs.data() + pos + sizeof(header) + header.name_size + i * sizeof(hash_t), sizeof(hash_t));
+				live.emplace(hash);
+			}
+
+			live_refs.insert(live_refs.end(), refs.begin() + pos, refs.begin() + pos + entry_size);
+		}
+
+		pos += entry_size;
+	}
+
+	if (live_refs.empty())
+	{
+		if (fs::remove_file(pool_path))
+		{
+			sys_log.success("Removed unused savestate page pool at '%s'.", pool_path);
+		}
+
+		fs::remove_file(ref_path);
+		return 0;
+	}
+
+	fs::file pool_file(pool_path);
+
+	if (!pool_file)
+	{
+		sys_log.error("Failed to open savestate page pool '%s' for compaction (%s)", pool_path, fs::g_tls_error);
+		return pool_stat.size + ref_stat.size;
+	}
+
+	// Find records which are not referenced anymore (or are incomplete)
+	u64 pos = 0;
+	usz dropped = 0;
+
+	for (page_pool_record record{}; pos + sizeof(record) <= pool_stat.size && pool_file.read(record);)
+	{
+		pos += sizeof(record) + record.size;
+		dropped += !live.contains(record.hash) || pos > pool_stat.size || record.data_size > chunk_size;
+		pool_file.seek(pos);
+	}
+
+	if (!dropped && pos == pool_stat.size && live_refs.size() == refs.size())
+	{
+		return pool_stat.size + ref_stat.size;
+	}
+
+	// Copy the referenced chunks to a new pool file
+	fs::pending_file new_pool(pool_path);
+
+	if (!new_pool.file)
+	{
+		sys_log.error("Failed to create savestate page pool '%s' (%s)", new_pool.get_temp_path(), fs::g_tls_error);
+		return pool_stat.size + ref_stat.size;
+	}
+
+	std::vector<u8> buffer;
+	u64 new_size = 0;
+
+	pool_file.seek(0);
+
+	for (page_pool_record record{}; pool_file.read(record) && record.data_size <= chunk_size;)
+	{
+		buffer.resize(record.size);
+
+		if (pool_file.read(buffer.data(), buffer.size()) != buffer.size())
+		{
+			break;
+		}
+
+		if (!live.contains(record.hash))
+		{
+			continue;
+		}
+
+		if (new_pool.file.write(&record, sizeof(record)) != sizeof(record) || new_pool.file.write(buffer.data(), buffer.size()) != buffer.size())
+		{
+			sys_log.error("Failed to write savestate page pool '%s' (%s)", new_pool.get_temp_path(), fs::g_tls_error);
+			return pool_stat.size + ref_stat.size;
+		}
+
+		new_size += sizeof(record) + buffer.size();
+	}
+
+	pool_file.close();
+
+	fs::pending_file new_refs(ref_path);
+
+	if (!new_refs.file || new_refs.file.write(live_refs.data(), live_refs.size()) != live_refs.size() || !new_refs.commit() || !new_pool.commit())
+	{
+		sys_log.error("Failed to compact savestate page pool '%s' (%s)", pool_path, fs::g_tls_error);
+		return pool_stat.size + ref_stat.size;
+	}
+
+	sys_log.success("Compacted savestate page pool at '%s' (removed chunks: %d, size: 0x%x -> 0x%x).", pool_path, dropped, pool_stat.size, new_size);
+	return new_size + live_refs.size();
+}
+
+void set_savestate_page_pool(const std::string& savestate_path)
+{
+	std::lock_guard lock(s_page_pool_mutex);
+
+	if (savestate_path.empty())
+	{
+		if (s_page_pool)
+		{
+			s_page_pool->commit();
+		}
+
+		s_page_pool.reset();
+		return;
+	}
+
+	const usz name_pos = savestate_path.find_last_of(fs::delim) + 1;
+	s_page_pool = std::make_unique<savestate_page_pool>(savestate_path.substr(0, name_pos), savestate_path.substr(name_pos));
+}
+
+savestate_page_pool* get_savestate_page_pool()
+{
+	return s_page_pool.get();
+}
+
+namespace
+{
+	// Savestate which is being written to disk in the background
+	struct pending_savestate_t
+	{
+		std::string path;
+		std::shared_ptr<std::vector<u8>> data;
+	};
+
+	shared_mutex s_pending_savestate_mutex;
+	pending_savestate_t s_pending_savestate;
+	atomic_t<u32> s_background_writers = 0;
+
+	// Read-only file view of a savestate which is being written, shares the data with the writer thread
+	struct pending_savestate_stream final : fs::file_base
+	{
+		std::shared_ptr<std::vector<u8>> data;
+		u64 pos = 0;
+
+		explicit pending_savestate_stream(std::shared_ptr<std::vector<u8>> data) noexcept
+			: data(std::move(data))
+		{
+		}
+
+		bool trunc(u64) override
+		{
+			fs::g_tls_error = fs::error::acces;
+			return false;
+		}
+
+		u64 read(void* buffer, u64 size) override
+		{
+			const u64 result = read_at(pos, buffer, size);
+			pos += result;
+			return result;
+		}
+
+		u64 read_at(u64 offset, void* buffer, u64 size) override
+		{
+			if (offset >= data->size())
+			{
+				return 0;
+			}
+
+			const u64 result = std::min<u64>(size, data->size() - offset);
+			std::memcpy(buffer, data->data() + offset, result);
+			return result;
+		}
+
+		u64 write(const void*, u64) override
+		{
+			fs::g_tls_error = fs::error::acces;
+			return 0;
+		}
+
+		u64 seek(s64 offset, fs::seek_mode whence) override
+		{
+			const s64 new_pos =
+				whence == fs::seek_set ? offset :
+				whence == fs::seek_cur ? offset + pos :
+				whence == fs::seek_end ? offset + data->size() : -1;
+
+			if (new_pos < 0)
+			{
+				fs::g_tls_error = fs::error::inval;
+				return -1;
+			}
+
+			pos = new_pos;
+			return pos;
+		}
+
+		u64 size() override
+		{
+			return data->size();
+		}
+	};
+}
+
+void write_savestate_in_background(std::string path, std::vector<u8>&& data, std::function<void(bool)> on_finish)
+{
+	auto shared_data = std::make_shared<std::vector<u8>>(std::move(data));
+
+	{
+		std::lock_guard lock(s_pending_savestate_mutex);
+		s_pending_savestate = {path, shared_data};
+	}
+
+	s_background_writers++;
+
+	std::thread([path = std::move(path), data = std::move(shared_data), on_finish = std::move(on_finish)]()
+	{
+		thread_base::set_name("Savestate Writer");
+
+		const u64 start_time = get_system_time();
+
+		fs::pending_file file(path);
+		bool success = false;
+
+		if (!file.file)
+		{
+			sys_log.error("Failed to create savestate temporary file! (path='%s', %s)", file.get_temp_path(), fs::g_tls_error);
+		}
+		else
+		{
+			{
+				utils::serial ar;
+				ar.m_file_handler = make_compressed_zstd_serialization_file_handler(file.file);
+
+				// Feed the compressor in 16MB parts to limit memory usage
+				for (usz pos = 0; pos < data->size(); pos += 0x100'0000)
+				{
+					ar.raw_serialize(data->data() + pos, std::min<usz>(data->size() - pos, 0x100'0000));
+					ar.breathe();
+				}
+
+				ar.seek_end();
+				ar.m_file_handler->finalize(ar);
+			}
+
+			success = file.commit();
+
+			if (!success)
+			{
+				sys_log.error("Failed to write savestate to file! (path='%s', %s)", path, fs::g_tls_error);
+			}
+		}
+
+		{
+			std::lock_guard lock(s_pending_savestate_mutex);
+
+			if (s_pending_savestate.data == data)
+			{
+				s_pending_savestate = {};
+			}
+		}
+
+		if (success)
+		{
+			sys_log.success("Savestate has been written in the background (path='%s', time=%gs)", path, (get_system_time() - start_time) / 1000000.);
+		}
+
+		if (on_finish)
+		{
+			on_finish(success);
+		}
+
+		s_background_writers--;
+		s_background_writers.notify_all();
+	}).detach();
+}
+
+void wait_for_background_savestate()
+{
+	for (u32 count = s_background_writers; count; count = s_background_writers)
+	{
+		s_background_writers.wait(count);
+	}
+}
+
 std::shared_ptr<utils::serial> make_savestate_reader(const std::string& path)
 {
 	std::shared_ptr<utils::serial> ar;
 
+	{
+		reader_lock lock(s_pending_savestate_mutex);
+
+		if (s_pending_savestate.data && s_pending_savestate.path == path)
+		{
+			// Read through a view of the data the writer thread is using (no copy of the whole state)
+			fs::file file;
+			file.reset(std::make_unique<pending_savestate_stream>(s_pending_savestate.data));
+
+			ar = std::make_shared<utils::serial>();
+			ar->set_reading_state();
+			ar->m_file_handler = make_uncompressed_serialization_file_handler(std::move(file));
+			return ar;
+		}
+	}
+
 	fs::file save{path, fs::isfile + fs::read};
 
 	if (!save)
@@ -513,9 +1045,15 @@ void clean_savestates(std::string_view title_id, std::string_view boot_path, usz
 
 	bool logged_limits = false;
 
+	// The page pool of delta savestates counts toward the disk space limit
+	const std::string dir_path = get_savestate_file(title_id, boot_path, -1, umax);
+	u64 pool_size = savestate_page_pool::collect_garbage(dir_path);
+
 	while (true)
 	{
-		const std::string to_remove = get_savestate_file(title_id, boot_path, max_files + 1, max_files_size == 0 ? u64{umax} : max_files_size);
+		// The most recent savestate is always kept
+		const u64 size_limit = max_files_size == 0 ? u64{umax} : std::max<u64>(max_files_size - std::min<u64>(pool_size, max_files_size), 1);
+		const std::string to_remove = get_savestate_file(title_id, boot_path, max_files + 1, size_limit);
 
 		if (to_remove.empty())
 		{
@@ -540,6 +1078,9 @@ void clean_savestates(std::string_view title_id, std::string_view boot_path, usz
 				sys_log.success("Removed old savestate file at '%s'.", to_remove);
 			}
 		}
+
+		// Drop chunks of the page pool which are not referenced anymore
+		pool_size = savestate_page_pool::collect_garbage(dir_path);
 	}
 }
 
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "util/serialization_ext.hpp"
+#include "Utilities/File.h"
+
+#include <map>
+#include <set>
 
 struct version_entry
 {
@@ -37,6 +41,60 @@ struct hle_locks_t
 	bool try_finalize(std::function<bool()> test);
 };
 
+// Content-addressed storage of guest memory chunks, shared by the delta savestates of a directory
+class savestate_page_pool
+{
+public:
+	static constexpr usz chunk_size = 0x10000;
+
+	using hash_t = std::array<u8, 20>;
+
+	savestate_page_pool(std::string dir_path, std::string state_name);
+
+	static hash_t hash(const u8* data, usz size);
+
+	// Append the chunk unless it is already stored
+	void store(const hash_t& hash, const u8* data, usz size);
+
+	// Returns false if the chunk is missing or its data is invalid
+	bool load(const hash_t& hash, u8* data, usz size);
+
+	// Record the chunks stored for the savestate being written (pages.ref)
+	void commit();
+
+	// Drop chunks which are no longer referenced by a savestate of the directory, returns the size of the pool files
+	static u64 collect_garbage(const std::string& dir_path);
+
+private:
+	struct entry_t
+	{
+		u64 offset;
+		u32 size;
+		u32 data_size;
+	};
+
+	bool open(bool write);
+
+	std::string m_path;
+	std::string m_ref_path;
+	std::string m_state_name;
+	fs::file m_file;
+	bool m_writable = false;
+	std::map<hash_t, entry_t> m_entries;
+	std::set<hash_t> m_used;
+	std::vector<u8> m_buffer;
+};
+
+// Select the page pool next to the specified savestate file (empty path to disable)
+void set_savestate_page_pool(const std::string& savestate_path);
+savestate_page_pool* get_savestate_page_pool();
+
+// Compress and write a serialized savestate to disk on a background thread
+// Until it is committed, make_savestate_reader() reads it from memory
+// on_finish is called with the result once the file has been committed or the write has failed
+void write_savestate_in_background(std::string path, std::vector<u8>&& data, std::function<void(bool)> on_finish);
+void wait_for_background_savestate();
+
 std::shared_ptr<utils::serial> make_savestate_reader(const std::string& path);
 bool load_and_check_reserved(utils::serial& ar, usz size);
 bool is_savestate_version_compatible(const std::vector<version_entry>& data, bool is_boot_check);
@@ -27,6 +27,7 @@ struct cfg_root : cfg::node
 		cfg::string llvm_cpu{ this, "Use LLVM CPU" };
 		cfg::_int<0, 1024> llvm_threads{ this, "Max LLVM Compile Threads", 0 };
 		cfg::_bool ppu_llvm_greedy_mode{ this, "PPU LLVM Greedy Mode", false, false };
+		cfg::_bool ppu_llvm_background_compile{ this, "PPU LLVM Background Compilation", false }; // Interpret modules loaded at runtime until their compilation in background is finished
 		cfg::_bool llvm_precompilation{ this, "LLVM Precompilation", true };
 		cfg::_enum<thread_scheduler_mode> thread_scheduler{this, "Thread Scheduler Mode", thread_scheduler_mode::os};
 		cfg::_bool set_daz_and_ftz{ this, "Set DAZ and FTZ", false };
@@ -44,6 +45,7 @@ struct cfg_root : cfg::node
 		cfg::_enum<spu_block_size_type> spu_block_size{ this, "SPU Block Size", spu_block_size_type::safe };
 		cfg::_bool spu_accurate_dma{ this, "Accurate SPU DMA", false };
 		cfg::_bool spu_accurate_reservations{ this, "Accurate SPU Reservations", true };
+		cfg::_bool spu_exact_reservation_waiters{ this, "Exact SPU Reservation Waiters", false }; // Per-cache-line notifier slots instead of hashed ones
 		cfg::_bool accurate_cache_line_stores{ this, "Accurate Cache Line Stores", false };
 		cfg::_bool rsx_accurate_res_access{this, "Accurate RSX reservation access", false, true};
 
@@ -61,6 +63,9 @@ struct cfg_root : cfg::node
 		fifo_setting rsx_fifo_accuracy{this, "RSX FIFO Accuracy", rsx_fifo_mode::fast };
 		cfg::_bool spu_verification{ this, "SPU Verification", true }; // Should be enabled
 		cfg::_bool spu_cache{ this, "SPU Cache", true };
+		cfg::_bool spu_llvm_object_cache{ this, "SPU LLVM Object Cache", false }; // Store compiled SPU programs as relocatable objects and load them on the next boot
+		cfg::_bool spu_asmjit_llvm_tier_up{ this, "SPU ASMJIT LLVM Tier-Up", false }; // Run new programs with ASMJIT and recompile them with LLVM in background
+		cfg::uint<0, 1000> spu_llvm_tier_up_threshold{ this, "SPU LLVM Tier-Up Threshold", 0, true }; // Number of profiler samples required to recompile a program with LLVM (0: recompile all)
 		cfg::_bool spu_prof{ this, "SPU Profiler", false };
 		cfg::uint<0, 16> mfc_transfers_shuffling{ this, "MFC Commands Shuffling Limit", 0 };
 		cfg::uint<0, 10000> mfc_transfers_timeout{ this, "MFC Commands Timeout", 0, true };
@@ -101,6 +106,7 @@ struct cfg_root : cfg::node
 
 		cfg::uint64 perf_report_threshold{this, "Performance Report Threshold", 500, true}; // In µs, 0.5ms = default, 0 = everything
 		cfg::_bool perf_report{this, "Enable Performance Report", false, true}; // Show certain perf-related logs
+		cfg::_bool perf_telemetry{this, "Export Performance Telemetry", false, true}; // Periodically write perf stats and CPU usage to the log directory (requires performance report)
 		cfg::_bool external_debugger{this, "Assume External Debugger"};
 	} core{ this };
 
@@ -153,6 +159,7 @@ struct cfg_root : cfg::node
 		cfg::_bool disable_video_output{ this, "Disable Video Output", false, true };
 		cfg::_bool disable_vertex_cache{ this, "Disable Vertex Cache", false };
 		cfg::_bool disable_FIFO_reordering{ this, "Disable FIFO Reordering", false };
+		cfg::_bool fifo_reordering_profile{ this, "Persist FIFO Reordering Profile", true };
 		cfg::_bool frame_skip_enabled{ this, "Enable Frame Skip", false, true };
 		cfg::_bool force_cpu_blit_processing{ this, "Force CPU Blit", false, true }; // Debugging option
 		cfg::_bool disable_on_disk_shader_cache{ this, "Disable On-Disk Shader Cache", false };
@@ -338,6 +345,9 @@ struct cfg_root : cfg::node
 		cfg::_bool compatible_mode{ this, "Compatible Savestate Mode", false }; // SPU emulation optimized for savestate compatibility (off by default for performance reasons)
 		cfg::_bool state_inspection_mode{ this, "Inspection Mode Savestates" }; // Save memory stored in executable files, thus allowing to view state without any files (for debugging)
 		cfg::_bool save_disc_game_data{ this, "Save Disc Game Data", false };
+		cfg::_bool background_write{ this, "Background Savestate Writing", false }; // Serialize to memory and compress/write to disk while emulation continues
+		cfg::_bool lazy_memory_load{ this, "Lazy Savestate Memory Loading", false }; // Restore main and video memory on first access (uncompressed or seekable savestates)
+		cfg::_bool delta_mode{ this, "Delta Savestates", false }; // Store memory in a pool shared between savestates, only write chunks not already stored
 		cfg::uint<0, 64> max_files{ this, "Maximum SaveState Files", 4 };
 		cfg::uint<0, 1024 * 512> max_files_size{ this, "Maximum SaveState Files Space (MiB)", 4096 };
 	} savestate{this};
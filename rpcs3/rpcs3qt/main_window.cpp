@@ -1069,6 +1069,7 @@ bool main_window::HandlePackageInstallation(QStringList file_paths, bool from_bo
 	// Wait for the completion
 	int reader_it = 0;
 	int set_text = -1;
+	u64 last_text_update = 0;
 
 	qt_events_aware_op(5, [&, readers_size = ::narrow<int>(readers.size())]()
 	{
@@ -1095,10 +1096,18 @@ bool main_window::HandlePackageInstallation(QStringList file_paths, bool from_bo
 		const int progress = readers[reader_it].get_progress(pdlg.maximum());
 		pdlg.SetValue(progress);
 
-		if (set_text != reader_it)
+		if (const u64 now = get_system_time(); set_text != reader_it || now - last_text_update >= 1'000'000)
 		{
-			pdlg.setLabelText(tr("Installing package (%0/%1), please wait...\n\n%2").arg(reader_it + 1).arg(readers_size).arg(get_app_info(packages[reader_it])));
+			QString text = tr("Installing package (%0/%1), please wait...\n\n%2").arg(reader_it + 1).arg(readers_size).arg(get_app_info(packages[reader_it]));
+
+			if (const u64 throughput = readers[reader_it].get_throughput())
+			{
+				text += tr("\n\n%0 MB/s").arg(throughput / (1024 * 1024));
+			}
+
+			pdlg.setLabelText(text);
 			set_text = reader_it;
+			last_text_update = now;
 		}
 
 		if (progress == pdlg.maximum())
@@ -65,6 +65,12 @@ namespace utils
 			return true;
 		}
 
+		// Data can be read at any position without processing the preceding data
+		virtual bool is_random_access() const
+		{
+			return false;
+		}
+
 		virtual void finalize(utils::serial&) = 0;
 	};
 
@@ -164,6 +164,21 @@ usz uncompressed_serialization_file_handler::get_size(const utils::serial& ar, u
 	return std::max<usz>(m_file->size(), memory_available);
 }
 
+void uncompressed_serialization_file_handler::skip_until(utils::serial& ar)
+{
+	if (ar.is_writing())
+	{
+		return;
+	}
+
+	if (ar.pos < ar.data_offset || ar.pos > ar.data_offset + ar.data.size())
+	{
+		// Relocate instead of reading skipped data
+		ar.data_offset = ar.pos;
+		ar.data.clear();
+	}
+}
+
 void uncompressed_serialization_file_handler::finalize(utils::serial& ar)
 {
 	ar.seek_end();
@@ -787,6 +802,17 @@ struct compressed_zstd_stream_data
 	lf_queue<std::vector<u8>> m_queued_data_to_write;
 };
 
+// Larger buffers are split into multiple frames in order to be compressed in parallel
+static constexpr usz c_zstd_max_frame_size = 0x400'0000;
+
+// Memory limit of frames decompressed in parallel
+static constexpr usz c_zstd_decode_batch_size = 0x1000'0000;
+
+// zstd seekable format: the seek table is stored in a skippable frame at the end of the file
+static constexpr u32 c_zstd_skippable_magic = 0x184D2A5E;
+static constexpr u32 c_zstd_seekable_magic = 0x8F92EAB1;
+static constexpr usz c_zstd_seek_footer_size = 9;
+
 void compressed_zstd_serialization_file_handler::initialize(utils::serial& ar)
 {
 	if (!m_stream)
@@ -811,6 +837,7 @@ void compressed_zstd_serialization_file_handler::initialize(utils::serial& ar)
 
 		m_compression_threads.clear();
 		m_file_writer_thread.reset();
+		m_frames.clear();
 
 		// Make sure at least one thread is free
 		// Limit thread count in order to make sure memory limits are under control (TODO: scale with RAM size)
@@ -840,7 +867,94 @@ void compressed_zstd_serialization_file_handler::initialize(utils::serial& ar)
 		m_stream->m_zs = ZSTD_createDStream();
 		m_read_inited = true;
 		m_errored = false;
+
+		if (!load_seek_table())
+		{
+			// Old file: read it as a single stream
+			m_frames.clear();
+		}
+	}
+}
+
+bool compressed_zstd_serialization_file_handler::load_seek_table()
+{
+	const usz file_size = *m_file ? m_file->size() : 0;
+
+	if (file_size < c_zstd_seek_footer_size + 8)
+	{
+		return false;
+	}
+
+	u8 footer[c_zstd_seek_footer_size]{};
+
+	if (m_file->read_at(file_size - sizeof(footer), footer, sizeof(footer)) != sizeof(footer))
+	{
+		return false;
+	}
+
+	// Footer: frame count, descriptor (no checksums), magic
+	const u32 count = read_from_ptr<le_t<u32>>(footer);
+
+	if (footer[4] != 0 || read_from_ptr<le_t<u32>>(footer + 5) != c_zstd_seekable_magic)
+	{
+		return false;
+	}
+
+	const usz table_size = usz{count} * 8 + sizeof(footer);
+
+	if (table_size + 8 > file_size)
+	{
+		return false;
+	}
+
+	std::vector<le_t<u32>> table(count * 2 + 2);
+
+	if (m_file->read_at(file_size - table_size - 8, table.data(), table.size() * 4) != table.size() * 4 || table[0] != c_zstd_skippable_magic || table[1] != table_size)
+	{
+		return false;
 	}
+
+	m_frames.resize(count);
+
+	usz file_offset = 0;
+	usz data_offset = 0;
+
+	for (usz i = 0; i < m_frames.size(); i++)
+	{
+		auto& frame = m_frames[i];
+		frame.file_offset = file_offset;
+		frame.data_offset = data_offset;
+		frame.file_size = table[2 + i * 2];
+		frame.data_size = table[3 + i * 2];
+
+		file_offset += frame.file_size;
+		data_offset += frame.data_size;
+	}
+
+	// Frames must be followed directly by the seek table
+	return file_offset == file_size - table_size - 8;
+}
+
+void compressed_zstd_serialization_file_handler::write_seek_table()
+{
+	std::vector<le_t<u32>> table;
+	table.reserve(m_frames.size() * 2 + 2);
+	table.push_back(c_zstd_skippable_magic);
+	table.push_back(::narrow<u32>(m_frames.size() * 8 + c_zstd_seek_footer_size));
+
+	for (const auto& frame : m_frames)
+	{
+		table.push_back(frame.file_size);
+		table.push_back(frame.data_size);
+	}
+
+	// Footer: frame count, descriptor (no checksums), magic
+	u8 footer[c_zstd_seek_footer_size]{};
+	write_to_ptr<le_t<u32>>(footer, ::size32(m_frames));
+	write_to_ptr<le_t<u32>>(footer + 5, c_zstd_seekable_magic);
+
+	m_file->write(table.data(), table.size() * sizeof(table[0]));
+	m_file->write(footer, sizeof(footer));
 }
 
 bool compressed_zstd_serialization_file_handler::handle_file_op(utils::serial& ar, usz pos, usz size, const void* data)
@@ -875,17 +989,33 @@ bool compressed_zstd_serialization_file_handler::handle_file_op(utils::serial& a
 
 		ar.seek_end();
 
-		const usz buffer_idx = m_input_buffer_index++ % m_compression_threads.size();
-		auto& input = m_compression_threads[buffer_idx].m_input;
+		const auto push_frame = [&](std::vector<u8>&& frame)
+		{
+			const usz buffer_idx = m_input_buffer_index++ % m_compression_threads.size();
+			auto& input = m_compression_threads[buffer_idx].m_input;
+
+			while (input)
+			{
+				// No waiting support on non-null pointer
+				thread_ctrl::wait_for(2'000);
+			}
+
+			input.store(stx::make_single_value(std::move(frame)));
+			input.notify_all();
+		};
 
-		while (input)
+		if (ar.data.size() <= c_zstd_max_frame_size)
 		{
-			// No waiting support on non-null pointer
-			thread_ctrl::wait_for(2'000);
+			push_frame(std::move(ar.data));
+		}
+		else
+		{
+			for (usz i = 0; i < ar.data.size(); i += c_zstd_max_frame_size)
+			{
+				const usz frame_size = std::min<usz>(c_zstd_max_frame_size, ar.data.size() - i);
+				push_frame(std::vector<u8>(ar.data.begin() + i, ar.data.begin() + i + frame_size));
+			}
 		}
-
-		input.store(stx::make_single_value(std::move(ar.data)));
-		input.notify_all();
 
 		ar.data_offset = ar.pos;
 		ar.data.clear();
@@ -957,20 +1087,23 @@ bool compressed_zstd_serialization_file_handler::handle_file_op(utils::serial& a
 		return false;
 	}
 
-	// TODO: Investigate if this optimization is worth an implementation for compressed stream
-	// if (ar.data.empty() && pos != ar.pos)
-	// {
-	// 	// Relocate instead of over-fetch
-	// 	ar.seek_pos(pos);
-	// }
+	if (!m_frames.empty() && ar.data.empty())
+	{
+		// Relocate instead of over-fetch (frames can be accessed randomly)
+		ar.data_offset = pos;
+	}
 
 	const usz read_pre_buffer = utils::sub_saturate<usz>(ar.data_offset, pos);
 
 	if (read_pre_buffer)
 	{
-		// Not allowed with compressed data for now
-		// Unless someone implements mechanism for it
-		ensure(false);
+		// Only possible with the seek table
+		ensure(!m_frames.empty());
+
+		ar.data.resize(ar.data.size() + read_pre_buffer);
+		std::memmove(ar.data.data() + read_pre_buffer, ar.data.data(), ar.data.size() - read_pre_buffer);
+		ensure(read_frames_at(pos, ar.data.data(), read_pre_buffer) == read_pre_buffer);
+		ar.data_offset -= read_pre_buffer;
 	}
 
 	// Adjustment to prevent overflow
@@ -1012,6 +1145,11 @@ usz compressed_zstd_serialization_file_handler::read_at(utils::serial& ar, usz r
 
 	initialize(ar);
 
+	if (!m_frames.empty())
+	{
+		return read_frames_at(read_pos, data, size);
+	}
+
 	auto& m_zd = m_stream->m_zd;
 
 	const usz total_to_read = size;
@@ -1100,9 +1238,126 @@ usz compressed_zstd_serialization_file_handler::read_at(utils::serial& ar, usz r
 	return read_size;
 }
 
+usz compressed_zstd_serialization_file_handler::read_frames_at(usz read_pos, void* data, usz size)
+{
+	usz read_size = 0;
+
+	while (read_size < size && !m_errored)
+	{
+		const usz pos = read_pos + read_size;
+
+		// Find the frame containing the position
+		const auto found = std::upper_bound(m_frames.begin(), m_frames.end(), pos, [](usz pos, const frame_info_t& frame)
+		{
+			return pos < frame.data_offset;
+		});
+
+		const usz index = found - m_frames.begin() - 1;
+
+		if (found == m_frames.begin() || pos >= m_frames[index].data_offset + m_frames[index].data_size)
+		{
+			// EOF
+			break;
+		}
+
+		if (index < m_decoded_first || index - m_decoded_first >= m_decoded.size())
+		{
+			decompress_frames(index);
+			continue;
+		}
+
+		const auto& frame_data = m_decoded[index - m_decoded_first];
+		const usz offset = pos - m_frames[index].data_offset;
+		const usz copy_size = std::min<usz>(size - read_size, frame_data.size() - offset);
+
+		std::memcpy(static_cast<u8*>(data) + read_size, frame_data.data() + offset, copy_size);
+		read_size += copy_size;
+	}
+
+	return read_size;
+}
+
+void compressed_zstd_serialization_file_handler::decompress_frames(usz first)
+{
+	// Decompress the following frames in parallel, within the memory limit
+	const usz max_threads = std::min<u32>(std::max<u32>(utils::get_thread_count(), 2) - 1, 16);
+
+	usz count = 0;
+
+	for (usz total = 0; count < max_threads && first + count < m_frames.size(); count++)
+	{
+		total += m_frames[first + count].data_size;
+
+		if (count && total > c_zstd_decode_batch_size)
+		{
+			break;
+		}
+	}
+
+	m_decoded.clear();
+	m_decoded.resize(count);
+	m_decoded_first = first;
+
+	atomic_t<usz> next = 0;
+
+	named_thread_group workers("CompressedRead Thread "sv, ::narrow<u32>(count), [&]()
+	{
+		ZSTD_DCtx* const dctx = ZSTD_createDCtx();
+		std::vector<u8> src;
+
+		for (usz i = next++; i < count && !m_errored; i = next++)
+		{
+			const auto& frame = m_frames[first + i];
+			auto& dst = m_decoded[i];
+
+			src.resize(frame.file_size);
+			dst.resize(frame.data_size);
+
+			if (m_file->read_at(frame.file_offset, src.data(), src.size()) != src.size())
+			{
+				sys_log.error("Failed to read compressed frame %u (offset=0x%x)", first + i, frame.file_offset);
+				m_errored = true;
+				break;
+			}
+
+			const usz res = ZSTD_decompressDCtx(dctx, dst.data(), dst.size(), src.data(), src.size());
+
+			if (ZSTD_isError(res) || res != dst.size())
+			{
+				sys_log.error("Failed to decompress frame %u (offset=0x%x, error='%s')", first + i, frame.file_offset, ZSTD_isError(res) ? ZSTD_getErrorName(res) : "size mismatch");
+				m_errored = true;
+				break;
+			}
+		}
+
+		ZSTD_freeDCtx(dctx);
+	});
+
+	workers.join();
+
+	if (m_errored)
+	{
+		m_decoded.clear();
+	}
+}
+
 void compressed_zstd_serialization_file_handler::skip_until(utils::serial& ar)
 {
-	ensure(!ar.is_writing() && ar.pos >= ar.data_offset);
+	ensure(!ar.is_writing());
+
+	if (!m_frames.empty())
+	{
+		if (ar.pos < ar.data_offset || ar.pos > ar.data_offset + ar.data.size())
+		{
+			// Relocate instead of decompressing skipped data (frames can be accessed randomly)
+			ar.data_offset = ar.pos;
+			ar.data.clear();
+		}
+
+		return;
+	}
+
+	ensure(ar.pos >= ar.data_offset);
 
 	if (ar.pos > ar.data_offset)
 	{
@@ -1126,6 +1381,8 @@ void compressed_zstd_serialization_file_handler::finalize(utils::serial& ar)
 		//ZSTD_decompressEnd(m_stream->m_zd);
 		ensure(ZSTD_freeDCtx(m_zd));
 		m_read_inited = false;
+		m_frames.clear();
+		m_decoded = {};
 		return;
 	}
 
@@ -1215,6 +1472,13 @@ void compressed_zstd_serialization_file_handler::finalize(utils::serial& ar)
 	m_compression_threads.clear();
 	m_file_writer_thread.reset();
 
+	if (!m_errored)
+	{
+		write_seek_table();
+	}
+
+	m_frames.clear();
+
 	m_stream_data = {};
 	m_write_inited = false;
 	ar.data = {}; // Deallocate and clear
@@ -1297,6 +1561,12 @@ void compressed_zstd_serialization_file_handler::file_writer_thread_op()
 			break;
 		}
 
+		// Frames are compressed in one shot so their content size is always known
+		const u64 data_size = ZSTD_getFrameContentSize(data->data(), data->size());
+		ensure(data_size <= c_zstd_max_frame_size);
+
+		m_frames.push_back(frame_info_t{0, 0, ::narrow<u32>(data->size()), static_cast<u32>(data_size)});
+
 		m_file->write(*data);
 	}
 }
@@ -1316,6 +1586,12 @@ usz compressed_zstd_serialization_file_handler::get_size(const utils::serial& ar
 		return memory_available;
 	}
 
+	if (!m_frames.empty())
+	{
+		// Exact size is known from the seek table
+		return std::max<usz>(m_frames.back().data_offset + m_frames.back().data_size, memory_available);
+	}
+
 	return recommended;
 	//return std::max<usz>(utils::mul_saturate<usz>(ZSTD_decompressBound(m_file->size()), 2), memory_available);
 }
@@ -41,6 +41,12 @@ struct uncompressed_serialization_file_handler : utils::serialization_file_handl
 	// Get available memory or file size
 	// Preferably memory size if is already greater/equal to recommended to avoid additional file ops
 	usz get_size(const utils::serial& ar, usz recommended) const override;
+	void skip_until(utils::serial& ar) override;
+
+	bool is_random_access() const override
+	{
+		return true;
+	}
 
 	void finalize(utils::serial& ar) override;
 };
@@ -153,6 +159,11 @@ struct compressed_zstd_serialization_file_handler : utils::serialization_file_ha
 		return !m_errored;
 	}
 
+	bool is_random_access() const override
+	{
+		return !m_frames.empty();
+	}
+
 	void finalize(utils::serial& ar) override;
 
 private:
@@ -183,7 +194,26 @@ private:
 	std::shared_ptr<compressed_zstd_stream_data> m_stream;
 	std::unique_ptr<named_thread<std::function<void()>>> m_file_writer_thread;
 
+	struct frame_info_t
+	{
+		usz file_offset;
+		usz data_offset;
+		u32 file_size;
+		u32 data_size;
+	};
+
+	// Independent zstd frames (seek table)
+	std::vector<frame_info_t> m_frames;
+
+	// Decompressed frames starting at m_decoded_first
+	std::vector<std::vector<u8>> m_decoded;
+	usz m_decoded_first = 0;
+
 	usz read_at(utils::serial& ar, usz read_pos, void* data, usz size);
+	usz read_frames_at(usz read_pos, void* data, usz size);
+	void decompress_frames(usz first);
+	bool load_seek_table();
+	void write_seek_table();
 	void initialize(utils::serial& ar);
 	void stream_data_prepare_thread_op();
 	void file_writer_thread_op();